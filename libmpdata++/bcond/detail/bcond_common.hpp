@@ -45,6 +45,12 @@ namespace libmpdataxx
 
         public:
 
+        // exchange batches (see solver_common::xchng_batch), relevant for remote bconds only:
+        // halos filled after batch_begin() are transferred together by batch_start() and batch_wait()
+        virtual void batch_begin() {}
+        virtual void batch_start() {}
+        virtual void batch_wait() {}
+
         // 1D
         virtual void fill_halos_sclr(arr_1d_t &, const bool deriv = false)
         {
@@ -206,8 +212,6 @@ namespace libmpdataxx
         virtual void avg_edge_and_halo1_sclr_cyclic(arr_3d_t &, const rng_t &, const rng_t &)
         {};
 
-        const bool single_threaded;
-
         protected:
           // sclr
         int
@@ -225,7 +229,6 @@ namespace libmpdataxx
         bcond_common(
           const rng_t &i,
           const std::array<int, n_dims> &,
-          bool single_threaded = false,
           const int thread_rank = -1, // -1 to indicate undefined
           const int thread_size = -1  // ditto
         ) :
@@ -269,7 +272,6 @@ namespace libmpdataxx
             (i^h^(-1)).last() - (halo - 1),
             (i^h^(-1)).last()
           ),
-          single_threaded(single_threaded),
           thread_rank(thread_rank),
           thread_size(thread_size)
         {}
@@ -8,6 +8,15 @@
 #include <libmpdata++/blitz.hpp>
 #include <libmpdata++/bcond/detail/bcond_common.hpp>
 #include <libmpdata++/formulae/arakawa_c.hpp>
+#include <libmpdata++/formulae/domain_decomposition.hpp>
+#include <libmpdata++/formulae/idxperm.hpp>
+
+#if defined(USE_MPI)
+#  include <boost/mpi/communicator.hpp>
+#  include <map>
+#endif
+
+#include <vector>
 
 namespace libmpdataxx
 {
@@ -17,34 +26,222 @@ namespace libmpdataxx
     {
       using namespace arakawa_c;
 
-      template <typename real_t, int halo, int n_dims>
+      // processes sharing a polar edge, i.e. those with the same coordinates as this one in all
+      // dimensions but x (see concurr_common::bc_set()): their ranks and x ranges in the order
+      // of x coordinates, and the x coordinate of this process; empty if x is not split among processes
+      struct polar_peers_t
+      {
+        std::vector<int> ranks;
+        std::vector<rng_t> slabs;
+        int coord = 0;
+      };
+
+      template <typename real_t, int halo, drctn_e dir, int n_dims>
       class polar_common : public bcond_common<real_t, halo, n_dims>
       {
         using parent_t = bcond_common<real_t, halo, n_dims>;
 
         protected:
 
+        using arr_t = blitz::Array<real_t, n_dims>;
+
         // member fields
         const int pole;
 
-        int polar_neighbours(const int j)
+        int polar_neighbours(const int j) const
         {
           return (j + pole) % (2 * pole);
         }
 
+        // what is filled, each with its own halo source (see polar_src())
+        enum { sclr_src, vctr_alng_src, vctr_nrml_src, n_src };
+
+        private:
+
+        // x split among processes
+        bool split = false;
+
+#if defined(USE_MPI)
+        boost::mpi::communicator mpicom;
+
+        // tags above those of remote bconds, distinct for each pair of sending and receiving threads and for each edge
+        static const int tag_base = 16384;
+
+        // halo columns (j) with polar neighbours in other processes, received from each of the
+        // sending threads, sent to each of the receiving threads, and with polar neighbours in this process
+        struct link_t
+        {
+          int rank, tag;
+          std::vector<int> cols;
+          std::vector<real_t> buf;
+        };
+        std::vector<link_t> sends, recvs;
+        std::vector<int> local_cols;
+
+        // polar neighbours of the halo columns of this thread gathered before filling
+        std::array<arr_t, n_src> ghost;
+        rng_t ghost_cols;
+#endif
+
+        static idx_t<n_dims> part(const rng_t &rows, const rng_t &cols, const rng_t &k)
+        {
+          using namespace idxperm;
+          constexpr int d = 1; // the polar edges are along x
+          if constexpr (n_dims == 2) return pi<d>(rows, cols);
+          else return pi<d>(rows, cols, k);
+        }
+
         public:
 
         // ctor
         polar_common(
           const rng_t &i,
           const std::array<int, n_dims> &distmem_grid_size,
-          bool = false,
-          const int = -1,
-          const int = -1
+          const int thread_rank = -1,
+          const int thread_size = -1,
+          const polar_peers_t &peers = polar_peers_t()
         ) :
-          parent_t(i, distmem_grid_size),
+          parent_t(i, distmem_grid_size, thread_rank, thread_size),
           pole((distmem_grid_size[0] - 1) / 2)
-        {}
+        {
+#if defined(USE_MPI)
+          const int n_coords = peers.ranks.size();
+          if (n_coords < 2) return;
+
+          // threads of each process share its polar edges in x slabs
+          const int
+            t_size = std::max(thread_size, 1),
+            t_rank = std::max(thread_rank, 0);
+          if (2 * t_size * t_size >= tag_base)
+            throw std::runtime_error("libmpdata++: too many threads for polar boundary conditions with MPI");
+
+          const auto base = [&](const int c, const int t) {
+            return domain_decomposition::slab(peers.slabs[c], t, t_size);
+          };
+          // a superset of the column ranges passed to the fill_halos_*() methods
+          const auto ext = [](const rng_t &r) {
+            return rng_t(r.first() - halo - 1, r.last() + halo + 1);
+          };
+          // the x coordinate and the thread of the process holding column j
+          const auto owner = [&](const int j) {
+            for (int c = 0; c < n_coords; ++c)
+              if (j >= peers.slabs[c].first() && j <= peers.slabs[c].last())
+                for (int t = 0; t < t_size; ++t)
+                  if (j <= base(c, t).last()) return std::make_pair(c, t);
+            assert(false && "polar neighbour outside of the domain");
+            throw;
+          };
+          split = true;
+
+          // receiving: halo columns of this thread
+          std::map<std::pair<int, int>, link_t> recv_map;
+          ghost_cols = ext(base(peers.coord, t_rank));
+          for (int j = ghost_cols.first(); j <= ghost_cols.last(); ++j)
+          {
+            const auto src = owner(polar_neighbours(j));
+            if (src.first == peers.coord)
+            {
+              local_cols.push_back(j);
+              continue;
+            }
+            auto &link = recv_map[src];
+            link.rank = peers.ranks[src.first];
+            link.tag = tag_base + 2 * (src.second * t_size + t_rank) + dir;
+            link.cols.push_back(j);
+          }
+          for (auto &link : recv_map) recvs.push_back(link.second);
+
+          // sending: columns of this thread that are polar neighbours of halo columns of threads of other processes
+          const rng_t own = base(peers.coord, t_rank);
+          for (int c = 0; c < n_coords; ++c)
+          {
+            if (c == peers.coord) continue;
+            for (int t = 0; t < t_size; ++t)
+            {
+              link_t link;
+              link.rank = peers.ranks[c];
+              link.tag = tag_base + 2 * (t_rank * t_size + t) + dir;
+              const rng_t cols = ext(base(c, t));
+              for (int j = cols.first(); j <= cols.last(); ++j)
+              {
+                const int pn = polar_neighbours(j);
+                if (pn >= own.first() && pn <= own.last()) link.cols.push_back(j);
+              }
+              if (!link.cols.empty()) sends.push_back(link);
+            }
+          }
+#endif
+        }
+
+        protected:
+
+        // the column the halo column j is filled from, in the array returned by polar_src()
+        int src_col(const int j) const
+        {
+          return split ? j : polar_neighbours(j);
+        }
+
+        // the array halos are filled from: a itself or, with x split among processes,
+        // the rows of a in the polar neighbours of the halo columns j (received from other
+        // processes if needed) indexed like the halo columns; to be called by all threads of
+        // all processes sharing the polar edge, in the same order
+        const arr_t &polar_src(const arr_t &a, const int src, const rng_t &rows, const rng_t &j, const rng_t &k = rng_t(0, 0))
+        {
+#if defined(USE_MPI)
+          if (!split) return a;
+          assert(j.first() >= ghost_cols.first() && j.last() <= ghost_cols.last());
+
+          arr_t &g = ghost[src];
+          const idx_t<n_dims> gidx = part(rows, ghost_cols, k);
+          if (g.numElements() == 0 || any(g.lbound() != gidx.lbound()) || any(g.ubound() != gidx.ubound()))
+          {
+            g.resize(blitz::TinyVector<int, n_dims>(gidx.ubound() - gidx.lbound() + 1));
+            g.reindexSelf(gidx.lbound());
+          }
+
+          const auto shape = [&](const int col) {
+            const idx_t<n_dims> p = part(rows, rng_t(col, col), k);
+            return blitz::TinyVector<int, n_dims>(p.ubound() - p.lbound() + 1);
+          };
+          const int col_size = product(shape(0));
+
+          std::vector<MPI_Request> reqs;
+          reqs.reserve(sends.size() + recvs.size());
+          for (auto &link : recvs)
+          {
+            link.buf.resize(link.cols.size() * col_size);
+            reqs.push_back(MPI_REQUEST_NULL);
+            MPI_Irecv(link.buf.data(), link.buf.size(), boost::mpi::get_mpi_datatype(real_t()), link.rank, link.tag, mpicom, &reqs.back());
+          }
+          for (auto &link : sends)
+          {
+            link.buf.resize(link.cols.size() * col_size);
+            for (std::size_t c = 0; c < link.cols.size(); ++c)
+            {
+              const int pn = polar_neighbours(link.cols[c]);
+              arr_t(link.buf.data() + c * col_size, shape(pn), blitz::neverDeleteData) = a(part(rows, rng_t(pn, pn), k));
+            }
+            reqs.push_back(MPI_REQUEST_NULL);
+            MPI_Isend(link.buf.data(), link.buf.size(), boost::mpi::get_mpi_datatype(real_t()), link.rank, link.tag, mpicom, &reqs.back());
+          }
+
+          for (const int jj : local_cols)
+          {
+            const int pn = polar_neighbours(jj);
+            g(part(rows, rng_t(jj, jj), k)) = a(part(rows, rng_t(pn, pn), k));
+          }
+
+          MPI_Waitall(reqs.size(), reqs.data(), MPI_STATUSES_IGNORE);
+
+          for (auto &link : recvs)
+            for (std::size_t c = 0; c < link.cols.size(); ++c)
+              g(part(rows, rng_t(link.cols[c], link.cols[c]), k)) = arr_t(link.buf.data() + c * col_size, shape(link.cols[c]), blitz::neverDeleteData);
+
+          return g;
+#else
+          return a;
+#endif
+        }
       };
     } // namespace detail
   } // namespace bcond
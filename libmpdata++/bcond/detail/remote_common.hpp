@@ -7,10 +7,21 @@
 
 #include <libmpdata++/bcond/detail/bcond_common.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #if defined(USE_MPI)
 #  include <boost/serialization/vector.hpp>
 #  include <boost/mpi/communicator.hpp>
 #  include <boost/mpi/nonblocking.hpp>
+#  include <boost/mpi/datatype.hpp>
 #endif
 
 namespace libmpdataxx
@@ -19,7 +30,62 @@ namespace libmpdataxx
   {
     namespace detail
     {
-      template <typename real_t, int halo, drctn_e dir, int n_dims>
+      // exchanges with a peer on the same node through memory shared by the two processes, in which
+      // the arrays are allocated (see sharedmem::old()): the receiver announces each message by writing
+      // the locations of its parts in its arrays to a slot of the sender (see concurr_common::shm_setup()),
+      // the sender then copies the data from its arrays directly to the receiver's halos,
+      // the slot header synchronising the two
+      struct remote_shm_t
+      {
+        struct header_t
+        {
+          alignas(64) std::atomic<std::uint64_t> seq; // number of messages written (by the sender)
+          alignas(64) std::atomic<std::uint64_t> ack; // number of messages announced (by the receiver)
+          int n_parts;                                // of the announced message
+        };
+        static constexpr std::size_t header_bytes = 3 * 64;
+        static_assert(sizeof(header_t) <= header_bytes, "");
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "atomics in memory shared by processes need to be lock-free");
+
+        // messages with more parts go through MPI
+        static constexpr int max_parts = 64;
+
+        // a part described by the index of the array, the offset of its first element and its extents and strides
+        static constexpr std::size_t desc_len(const int n_dims) { return 2 + 2 * n_dims; }
+
+        static constexpr std::size_t slot_bytes(const int n_dims)
+        {
+          return header_bytes + max_parts * desc_len(n_dims) * sizeof(std::int64_t);
+        }
+
+        char *send = nullptr, *recv = nullptr; // slots of the messages sent by this process and of those it receives
+        std::vector<std::pair<char*, std::size_t>> arrs; // the arrays of this process (see distmem::shm_arrs())
+        std::vector<char*> peer_arrs;                    // the same arrays of the peer, empty if it is on another node
+
+        header_t *hdr(char *slot) const { return reinterpret_cast<header_t*>(slot); }
+
+        std::int64_t *descs(char *slot) const { return reinterpret_cast<std::int64_t*>(slot + header_bytes); }
+
+        template <class cond_t>
+        static void spin(const cond_t &cond)
+        {
+          for (int i = 0; !cond(); ++i)
+            if (i > 1000) std::this_thread::yield();
+        }
+      };
+
+      // one-sided exchanges (with LIBMPDATAXX_MPI_RMA, see distmem): the window exposing the arrays of
+      // the process and the counters of the bcond in it, which are updated by the peer
+      struct remote_rma_t
+      {
+#if defined(USE_MPI)
+        MPI_Win win = MPI_WIN_NULL;
+#endif
+        std::int64_t *cnt = nullptr; // null if two-sided exchanges are to be used
+        enum { seq, ack, next };     // messages put into the halos, halos of the peer ready for the next message, id of its parts
+      };
+
+      template <typename real_t, int halo, drctn_e dir, int n_dims, int d>
       class remote_common : public detail::bcond_common<real_t, halo, n_dims>
       {
         using parent_t = detail::bcond_common<real_t, halo, n_dims>;
@@ -29,43 +95,462 @@ namespace libmpdataxx
         using arr_t = blitz::Array<real_t, n_dims>;
         using idx_t = blitz::RectDomain<n_dims>;
 
-        real_t *buf_send,
-               *buf_recv;
-
         private:
 
 #if defined(USE_MPI)
         boost::mpi::communicator mpicom;
 
-#  if defined(NDEBUG)
-        static const int n_reqs = 2; // data, reqs for recv only is enough?
-        static const int n_dbg_send_reqs = 0;
-        static const int n_dbg_tags = 0;
-#  else
-        static const int n_reqs = 4; // data + ranges
-        static const int n_dbg_send_reqs = 1;
+#  if !defined(NDEBUG)
         static const int n_dbg_tags = 2;
+        std::array<boost::mpi::request, 2> dbg_reqs; // number of parts and elements sent along with the data
+        std::pair<int, int> buf_rng, dbg_rng; // received and expected number of parts and elements
+#  endif
+
+        // rank of the neighbouring process in dimension d
+        const int peer;
+
+        // message tags distinct for each dimension and, if more threads communicate
+        // along the same edge (e.g. y edges in 2D), for each thread
+        const int tag_base;
+
+        // halos are sent and received in place (no copying to/from buffers) using derived datatypes
+        // describing the strided parts of arrays; a message consists of one or more such parts
+        // (more if batched, see batch_begin()) and gets a persistent request created on first use
+
+        // a part is identified by the address of its first element and its extents and strides
+        using part_t = std::pair<const real_t*, std::array<int, 2 * n_dims>>;
+        std::map<part_t, MPI_Datatype> part_types;
+
+        struct persistent_t
+        {
+          MPI_Datatype type;
+          MPI_Request req;
+        };
+        std::map<std::vector<part_t>, persistent_t> send_reqs, recv_reqs;
+
+        // parts of the messages to be sent/received
+        std::vector<part_t> send_parts, recv_parts;
+        bool batching = false;
+
+        // requests started and not yet waited for
+        MPI_Request *pending_send = nullptr, *pending_recv = nullptr;
+
+        // node-local peer: shared memory slots and arrays, number of messages sent/announced through them,
+        // parts of the message to be copied to the peer once it is announced (see wait_send())
+        const remote_shm_t shm;
+        std::uint64_t shm_n_sent = 0, shm_n_recvd = 0;
+        std::vector<part_t> shm_send_parts;
+        bool shm_recv_pending = false;
+
+        // one-sided exchanges: the receiver announces each message by storing the id of its parts (the parts
+        // themselves being sent once, as absolute addresses, extents and strides) and incrementing the ack
+        // counter of the sender, who then puts the data directly into the receiver's halos and increments
+        // the receiver's seq counter; transfers in the passive-target epoch opened by distmem
+        const remote_rma_t rma;
+        int rma_rank;
+        MPI_Aint rma_cnt_addr, rma_peer_cnt_addr; // counters of this bcond and of the peer's one
+        std::array<MPI_Request, 2> rma_addr_reqs;
+        bool rma_addr_known = false;
+        std::int64_t rma_n_sent = 0, rma_n_recvd = 0;
+        bool rma_recv_pending = false;
+        std::map<std::vector<part_t>, int> rma_recv_ids;
+        std::vector<std::vector<MPI_Aint>> rma_descs; // descriptions of parts being sent to the peer
+        std::vector<MPI_Request> rma_desc_reqs;
+        struct rma_target_t
+        {
+          MPI_Aint addr; // of the first part
+          MPI_Datatype type;
+          int n_elems;
+        };
+        std::vector<rma_target_t> rma_targets; // indexed by the ids of the peer
+        std::map<std::vector<part_t>, MPI_Datatype> rma_origin_types;
+        std::vector<part_t> rma_send_parts; // put once the peer is ready (see wait_send())
+
+        // dimensions in the order of increasing strides
+        static std::array<int, n_dims> ordering(const std::array<int, 2 * n_dims> &es)
+        {
+          std::array<int, n_dims> ord;
+          std::iota(ord.begin(), ord.end(), 0);
+          std::sort(ord.begin(), ord.end(), [&](const int a, const int b) { return es[2 * a + 1] < es[2 * b + 1]; });
+          return ord;
+        }
+
+        static int n_elems(const part_t &part)
+        {
+          int n = 1;
+          for (int dim = 0; dim < n_dims; ++dim) n *= part.second[2 * dim];
+          return n;
+        }
+
+        static int n_elems(const std::vector<part_t> &parts)
+        {
+          int n = 0;
+          for (const auto &part : parts) n += n_elems(part);
+          return n;
+        }
+
+        // copying a part to another one with the same extents, in the order of dimensions with increasing
+        // strides (the same for both parts, as the storage order is, the strides differing with the array shapes)
+        static void copy_part(const part_t &src, const part_t &dst)
+        {
+          const auto ord = ordering(src.second);
+          const auto ext = [&](const int r) { return src.second[2 * ord[r]]; };
+          const auto str = [&](const part_t &part, const int r) { return part.second[2 * ord[r] + 1]; };
+
+          const int n_in = ext(0), n_out = n_elems(src) / n_in;
+          for (int o = 0; o < n_out; ++o)
+          {
+            const real_t *from = src.first;
+            real_t *to = const_cast<real_t*>(dst.first);
+            for (int r = 1, rem = o; r < n_dims; rem /= ext(r), ++r)
+            {
+              from += (rem % ext(r)) * str(src, r);
+              to   += (rem % ext(r)) * str(dst, r);
+            }
+            for (int i = 0; i < n_in; ++i) to[i * str(dst, 0)] = from[i * str(src, 0)];
+          }
+        }
+
+        // index of the array in shared memory holding the part and the offset of its first element in it
+        bool shm_locate(const part_t &part, std::int64_t &arr, std::int64_t &off) const
+        {
+          const auto p = reinterpret_cast<std::uintptr_t>(part.first);
+          for (std::size_t a = 0; a < shm.arrs.size(); ++a)
+          {
+            const auto beg = reinterpret_cast<std::uintptr_t>(shm.arrs[a].first);
+            if (p < beg || p >= beg + shm.arrs[a].second) continue;
+            arr = a;
+            off = (p - beg) / sizeof(real_t);
+            return true;
+          }
+          return false;
+        }
+
+        // node-local peer and parts in the arrays in shared memory (decided alike on both sides,
+        // the messages consisting of the same number of parts of the same arrays)
+        bool shm_direct(const std::vector<part_t> &parts) const
+        {
+          if (shm.peer_arrs.empty() || parts.size() > remote_shm_t::max_parts) return false;
+          std::int64_t arr, off;
+          for (const auto &part : parts) if (!shm_locate(part, arr, off)) return false;
+          return true;
+        }
+
+        void shm_announce(const std::vector<part_t> &parts)
+        {
+          auto *hdr = shm.hdr(shm.recv);
+          std::int64_t *desc = shm.descs(shm.recv);
+          for (const auto &part : parts)
+          {
+            shm_locate(part, desc[0], desc[1]);
+            std::copy(part.second.begin(), part.second.end(), desc + 2);
+            desc += remote_shm_t::desc_len(n_dims);
+          }
+          hdr->n_parts = parts.size();
+          hdr->ack.store(++shm_n_recvd, std::memory_order_release);
+          shm_recv_pending = true;
+        }
+
+        void shm_put()
+        {
+          auto *hdr = shm.hdr(shm.send);
+          ++shm_n_sent;
+          // waiting until the peer has announced where the message goes
+          remote_shm_t::spin([&]{ return hdr->ack.load(std::memory_order_acquire) == shm_n_sent; });
+          assert(hdr->n_parts == int(shm_send_parts.size()) && "remote bcond: message parts do not match those received by the neighbour");
+
+          const std::int64_t *desc = shm.descs(shm.send);
+          for (const auto &part : shm_send_parts)
+          {
+            part_t dst(reinterpret_cast<const real_t*>(shm.peer_arrs.at(desc[0])) + desc[1], {});
+            std::copy(desc + 2, desc + remote_shm_t::desc_len(n_dims), dst.second.begin());
+            assert(n_elems(dst) == n_elems(part) && "remote bcond: message parts do not match those received by the neighbour");
+            copy_part(part, dst);
+            desc += remote_shm_t::desc_len(n_dims);
+          }
+          hdr->seq.store(shm_n_sent, std::memory_order_release);
+          shm_send_parts.clear();
+        }
+
+        void shm_wait_recv()
+        {
+          auto *hdr = shm.hdr(shm.recv);
+          remote_shm_t::spin([&]{ return hdr->seq.load(std::memory_order_acquire) == shm_n_recvd; });
+          shm_recv_pending = false;
+        }
+
+        // datatype describing a part with the given extents and strides relative to the address of its first element
+        static MPI_Datatype part_type(const std::array<int, 2 * n_dims> &es)
+        {
+          // nested hvectors, starting from the dimension varying fastest in memory
+          const auto ord = ordering(es);
+          MPI_Datatype type = boost::mpi::get_mpi_datatype(real_t());
+          for (int r = 0; r < n_dims; ++r)
+          {
+            const int dim = ord[r];
+            MPI_Datatype next;
+            MPI_Type_create_hvector(es[2 * dim], 1, MPI_Aint(es[2 * dim + 1] * sizeof(real_t)), type, &next);
+            if (r > 0) MPI_Type_free(&type);
+            type = next;
+          }
+          MPI_Type_commit(&type);
+          return type;
+        }
+
+        // struct of parts of given types at given displacements
+        static MPI_Datatype struct_type(const std::vector<MPI_Aint> &displs, const std::vector<MPI_Datatype> &types)
+        {
+          std::vector<int> blocklens(types.size(), 1);
+          MPI_Datatype type;
+          MPI_Type_create_struct(types.size(), blocklens.data(), displs.data(), types.data(), &type);
+          MPI_Type_commit(&type);
+          return type;
+        }
+
+        // struct of the parts at their absolute addresses
+        MPI_Datatype struct_type(const std::vector<part_t> &parts) const
+        {
+          std::vector<MPI_Aint> displs(parts.size());
+          std::vector<MPI_Datatype> types(parts.size());
+          for (std::size_t p = 0; p < parts.size(); ++p)
+          {
+            MPI_Get_address(parts[p].first, &displs[p]);
+            types[p] = part_types.at(parts[p]);
+          }
+          return struct_type(displs, types);
+        }
+
+        // atomic access to the counters of this bcond and updates of those of the peer
+        std::int64_t rma_load(const int c) const
+        {
+          const std::int64_t none = 0;
+          std::int64_t val;
+          MPI_Fetch_and_op(&none, &val, MPI_INT64_T, rma_rank, MPI_Aint_add(rma_cnt_addr, c * sizeof(std::int64_t)), MPI_NO_OP, rma.win);
+          MPI_Win_flush(rma_rank, rma.win);
+          return val;
+        }
+
+        void rma_update(const int c, const std::int64_t val, const MPI_Op op) const
+        {
+          MPI_Accumulate(&val, 1, MPI_INT64_T, peer, MPI_Aint_add(rma_peer_cnt_addr, c * sizeof(std::int64_t)), 1, MPI_INT64_T, op, rma.win);
+          MPI_Win_flush(peer, rma.win);
+        }
+
+        void rma_wait_addr()
+        {
+          if (rma_addr_known) return;
+          MPI_Waitall(2, rma_addr_reqs.data(), MPI_STATUSES_IGNORE);
+          rma_addr_known = true;
+        }
+
+        void rma_start_recv(const std::vector<part_t> &parts)
+        {
+          auto it = rma_recv_ids.find(parts);
+          if (it == rma_recv_ids.end())
+          {
+            std::vector<MPI_Aint> desc;
+            for (const auto &part : parts)
+            {
+              MPI_Aint addr;
+              MPI_Get_address(part.first, &addr);
+              desc.push_back(addr);
+              desc.insert(desc.end(), part.second.begin(), part.second.end());
+            }
+            rma_descs.push_back(std::move(desc));
+            rma_desc_reqs.push_back(MPI_REQUEST_NULL);
+            MPI_Isend(rma_descs.back().data(), rma_descs.back().size(), MPI_AINT, peer, msg_send(), mpicom, &rma_desc_reqs.back());
+            const int id = rma_recv_ids.size();
+            it = rma_recv_ids.emplace(parts, id).first;
+          }
+
+          rma_wait_addr();
+          // the id has to be there before the peer sees the ack
+          rma_update(remote_rma_t::next, it->second, MPI_REPLACE);
+          rma_update(remote_rma_t::ack, 1, MPI_SUM);
+          rma_recv_pending = true;
+        }
+
+        // receiving the description of the parts of the next id of the peer
+        rma_target_t rma_target()
+        {
+          MPI_Status st;
+          int n;
+          MPI_Probe(peer, msg_recv(), mpicom, &st);
+          MPI_Get_count(&st, MPI_AINT, &n);
+          std::vector<MPI_Aint> desc(n);
+          MPI_Recv(desc.data(), n, MPI_AINT, peer, msg_recv(), mpicom, MPI_STATUS_IGNORE);
+
+          const int n_parts = n / (1 + 2 * n_dims);
+          std::vector<MPI_Aint> displs(n_parts);
+          std::vector<MPI_Datatype> types(n_parts);
+          rma_target_t target{desc[0], MPI_DATATYPE_NULL, 0};
+          for (int p = 0; p < n_parts; ++p)
+          {
+            const MPI_Aint *dsc = &desc[p * (1 + 2 * n_dims)];
+            std::array<int, 2 * n_dims> es;
+            std::copy(dsc + 1, dsc + 1 + 2 * n_dims, es.begin());
+            displs[p] = MPI_Aint_diff(dsc[0], target.addr);
+            types[p] = part_type(es);
+            target.n_elems += n_elems(part_t(nullptr, es));
+          }
+          target.type = struct_type(displs, types);
+          for (auto &t : types) MPI_Type_free(&t);
+          return target;
+        }
+
+        void rma_put()
+        {
+          rma_wait_addr();
+          ++rma_n_sent;
+          remote_shm_t::spin([&]{ return rma_load(remote_rma_t::ack) >= rma_n_sent; });
+          const int id = rma_load(remote_rma_t::next);
+          while (int(rma_targets.size()) <= id) rma_targets.push_back(rma_target()); // sent in the order of ids
+          const auto &target = rma_targets[id];
+          assert(target.n_elems == n_elems(rma_send_parts) && "remote bcond: message parts do not match those received by the neighbour");
+
+          auto it = rma_origin_types.find(rma_send_parts);
+          if (it == rma_origin_types.end())
+            it = rma_origin_types.emplace(rma_send_parts, struct_type(rma_send_parts)).first;
+
+          MPI_Put(MPI_BOTTOM, 1, it->second, peer, target.addr, 1, target.type, rma.win);
+          // the data has to be there before the peer sees the seq
+          MPI_Win_flush(peer, rma.win);
+          rma_update(remote_rma_t::seq, 1, MPI_SUM);
+          rma_send_parts.clear();
+        }
+
+        void rma_wait_recv()
+        {
+          ++rma_n_recvd;
+          remote_shm_t::spin([&]{ return rma_load(remote_rma_t::seq) >= rma_n_recvd; });
+          // making the data put by the peer visible to this process
+          MPI_Win_sync(rma.win);
+          rma_recv_pending = false;
+
+          // the peer has got the descriptions of the parts by now
+          MPI_Waitall(rma_desc_reqs.size(), rma_desc_reqs.data(), MPI_STATUSES_IGNORE);
+          rma_desc_reqs.clear();
+          rma_descs.clear();
+        }
+
+        static int size(const idx_t &idx)
+        {
+          int ret = 1;
+          for (int dim = 0; dim < n_dims; ++dim) ret *= idx.ubound(dim) - idx.lbound(dim) + 1;
+          return ret;
+        }
+
+        void add_part(std::vector<part_t> &parts, const arr_t &a, const idx_t &idx)
+        {
+          part_t part(&a(idx.lbound()), {});
+          for (int dim = 0; dim < n_dims; ++dim)
+          {
+            part.second[2 * dim]     = idx.ubound(dim) - idx.lbound(dim) + 1;
+            part.second[2 * dim + 1] = a.stride(dim);
+          }
+          if (part_types.find(part) == part_types.end())
+            part_types.emplace(part, part_type(part.second));
+          parts.push_back(part);
+        }
+
+        // starts the transfer of the collected parts as a single message
+        MPI_Request *start(
+          std::map<std::vector<part_t>, persistent_t> &reqs,
+          std::vector<part_t> &parts,
+          const bool is_send,
+          const int tag
+        )
+        {
+          if (parts.empty()) return nullptr;
+
+          // node-local peer, with the data put by the sender once the receiver has announced the message
+          if (shm_direct(parts))
+          {
+            if (is_send) shm_send_parts.swap(parts);
+            else shm_announce(parts);
+            parts.clear();
+            return nullptr;
+          }
+
+          // one-sided, with the data put by the sender once the receiver is ready
+          if (rma.cnt != nullptr)
+          {
+            if (is_send) rma_send_parts.swap(parts);
+            else rma_start_recv(parts);
+            parts.clear();
+            return nullptr;
+          }
+
+          auto it = reqs.find(parts);
+          if (it == reqs.end())
+          {
+            persistent_t pr;
+            pr.type = struct_type(parts);
+            if (is_send) MPI_Send_init(MPI_BOTTOM, 1, pr.type, peer, tag, mpicom, &pr.req);
+            else         MPI_Recv_init(MPI_BOTTOM, 1, pr.type, peer, tag, mpicom, &pr.req);
+            it = reqs.emplace(parts, pr).first;
+          }
+          MPI_Start(&it->second.req);
+
+#  if !defined(NDEBUG)
+          if (is_send)
+            dbg_reqs[0] = mpicom.isend(peer, tag + n_dbg_tags, std::pair<int, int>(parts.size(), n_elems(parts)));
+          else
+          {
+            dbg_reqs[1] = mpicom.irecv(peer, tag + n_dbg_tags, buf_rng);
+            dbg_rng = std::pair<int, int>(parts.size(), n_elems(parts));
+          }
 #  endif
 
-        std::array<boost::mpi::request, n_reqs> reqs;
+          parts.clear();
+          return &it->second.req;
+        }
+
+        // distinguishing between left and right messages
+        // (important e.g. with 2 procs and cyclic bc)
+        int msg_send() const { return tag_base + (dir == left ? left : rght); }
+        int msg_recv() const { return tag_base + (dir == left ? rght : left); }
 
-        const int peer = dir == left
-          ? (mpicom.rank() - 1 + mpicom.size()) % mpicom.size()
-          : (mpicom.rank() + 1                ) % mpicom.size();
+        void start_send()
+        {
+          pending_send = start(send_reqs, send_parts, true, msg_send());
+        }
 
+        void start_recv()
+        {
+          pending_recv = start(recv_reqs, recv_parts, false, msg_recv());
+        }
+
+        void wait_send()
+        {
+          if (!shm_send_parts.empty()) shm_put();
+          if (!rma_send_parts.empty()) rma_put();
+          if (pending_send == nullptr) return;
+          MPI_Wait(pending_send, MPI_STATUS_IGNORE);
+          pending_send = nullptr;
+#  if !defined(NDEBUG)
+          dbg_reqs[0].wait();
+#  endif
+        }
+
+        void wait_recv()
+        {
+          if (shm_recv_pending) shm_wait_recv();
+          if (rma_recv_pending) rma_wait_recv();
+          if (pending_recv == nullptr) return;
+          MPI_Wait(pending_recv, MPI_STATUS_IGNORE);
+          pending_recv = nullptr;
 #  if !defined(NDEBUG)
-          std::pair<int, int> buf_rng;
+          dbg_reqs[1].wait();
+          assert(buf_rng == dbg_rng && "remote bcond: message parts do not match those sent by the neighbour");
 #  endif
+        }
 #endif
 
         protected:
-        const bool is_cyclic =
-#if defined(USE_MPI)
-          (dir == left && mpicom.rank() == 0) ||
-          (dir == rght && mpicom.rank() == mpicom.size()-1);
-#else
-          false;
-#endif
+
+        // edge of the whole domain in dimension d (with cyclic bcond)
+        const bool is_cyclic;
 
         void send_hlpr(
           const arr_t &a,
@@ -73,37 +558,10 @@ namespace libmpdataxx
         )
         {
 #if defined(USE_MPI)
-          // distinguishing between left and right messages
-          // (important e.g. with 2 procs and cyclic bc)
-          const int
-            msg_send = dir == left ? left : rght;
-
-//          std::cerr << "send_hlpr idx dir " << dir << " : " 
-//            << " (" << idx_send.lbound(0) << ", " << idx_send.ubound(0) << ")"  
-//            << " (" << idx_send.lbound(1) << ", " << idx_send.ubound(1) << ")"  
-//            << " (" << idx_send.lbound(2) << ", " << idx_send.ubound(2) << ")"  
-//            << std::endl;
-
-          // arr_send references part of the send buffer that will be used
-          arr_t arr_send(buf_send, a(idx_send).shape(), blitz::neverDeleteData);
-          // copying data to be sent
-          arr_send = a(idx_send);
-
-          // launching async data transfer
-          if(arr_send.size()!=0)
-          {
-            // use the pointer+size kind of send instead of serialization of blitz arrays, because
-            // serialization caused memory leaks, probably because it breaks blitz reference counting
-            reqs[0] = mpicom.isend(peer, msg_send, buf_send, arr_send.size());
-
-            // sending debug information
-#  if !defined(NDEBUG)
-            reqs[1] = mpicom.isend(peer, msg_send + n_dbg_tags, std::pair<int,int>(
-              idx_send[0].first(),
-              idx_send[0].last()
-            ));
-#  endif
-          }
+          if(size(idx_send) == 0) return;
+          add_part(send_parts, a, idx_send);
+          // launching async data transfer (unless batching)
+          if (!batching) start_send();
 #else
           assert(false);
 #endif
@@ -115,26 +573,10 @@ namespace libmpdataxx
         )
         {
 #if defined(USE_MPI)
-          const int
-            msg_recv = dir == left ? rght : left;
-
-//          std::cerr << "recv_hlpr idx dir " << dir << " : " 
-//            << " (" << idx_recv.lbound(0) << ", " << idx_recv.ubound(0) << ")"  
-//            << " (" << idx_recv.lbound(1) << ", " << idx_recv.ubound(1) << ")"  
-//            << " (" << idx_recv.lbound(2) << ", " << idx_recv.ubound(2) << ")"  
-//            << std::endl;
-
-
-          // launching async data transfer
-          if(a(idx_recv).size()!=0) // TODO: test directly size of idx_recv
-          {
-            reqs[1+n_dbg_send_reqs] = mpicom.irecv(peer, msg_recv, buf_recv, a(idx_recv).size());
-
-            // sending debug information
-#  if !defined(NDEBUG)
-            reqs[3] = mpicom.irecv(peer, msg_recv + n_dbg_tags, buf_rng);
-#  endif
-          }
+          if(size(idx_recv) == 0) return;
+          add_part(recv_parts, a, idx_recv);
+          // launching async data transfer (unless batching)
+          if (!batching) start_recv();
 #else
           assert(false);
 #endif
@@ -149,7 +591,7 @@ namespace libmpdataxx
           send_hlpr(a, idx_send);
 
           // waiting for the transfers to finish
-          boost::mpi::wait_all(reqs.begin(), reqs.begin() + 1 + n_dbg_send_reqs); // MPI_Waitall is thread-safe?
+          if (!batching) wait_send();
 #else
           assert(false);
 #endif
@@ -161,24 +603,10 @@ namespace libmpdataxx
         )
         {
 #if defined(USE_MPI)
-          //auto arr_recv = recv_hlpr(a, idx_recv);
           recv_hlpr(a, idx_recv);
 
-          // waiting for the transfers to finish
-          boost::mpi::wait_all(reqs.begin() + 1 + n_dbg_send_reqs, reqs.end()); // MPI_Waitall is thread-safe?
-
-          // a blitz handler for the used part of the receive buffer
-          arr_t arr_recv(buf_recv, a(idx_recv).shape(), blitz::neverDeleteData); // TODO: shape directly from idx_recv
-
-          // checking debug information
-
-          // positive modulo (grid_size_0 - 1)
-//          auto wrap = [this](int n) {return (n % (grid_size_0 - 1) + grid_size_0 - 1) % (grid_size_0 - 1);};
-//          assert(wrap(buf_rng.first) == wrap(idx_recv[0].first()));
-//          assert(wrap(buf_rng.second) == wrap(idx_recv[0].last()));
-
-          // writing received data to the array
-          a(idx_recv) = arr_recv;
+          // waiting for the transfers to finish, data is written directly to the array
+          if (!batching) wait_recv();
 #else
           assert(false);
 #endif
@@ -194,21 +622,12 @@ namespace libmpdataxx
           send_hlpr(a, idx_send);
           recv_hlpr(a, idx_recv);
 
-          // waiting for the transfers to finish
-          boost::mpi::wait_all(reqs.begin(), reqs.end());
-
-          // a blitz handler for the used part of the receive buffer
-          arr_t arr_recv(buf_recv, a(idx_recv).shape(), blitz::neverDeleteData);
-
-          // checking debug information
-
-          // positive modulo (grid_size_0 - 1)
-         // auto wrap = [this](int n) {return (n % (grid_size_0 - 1) + grid_size_0 - 1) % (grid_size_0 - 1);};
-         // assert(wrap(buf_rng.first) == wrap(idx_recv[0].first()));
-         // assert(wrap(buf_rng.second) == wrap(idx_recv[0].last()));
-
-          // writing received data to the array
-          a(idx_recv) = arr_recv;
+          // waiting for the transfers to finish, data is written directly to the array
+          if (!batching)
+          {
+            wait_send();
+            wait_recv();
+          }
 #else
           assert(false);
 #endif
@@ -220,25 +639,55 @@ namespace libmpdataxx
         remote_common(
           const rng_t &i,
           const std::array<int, n_dims> &distmem_grid_size,
-          bool single_threaded = false,
+          const int peer,
+          const bool is_cyclic,
           const int thread_rank = -1, 
-          const int thread_size = -1 
+          const int thread_size = -1,
+          const remote_shm_t &shm = remote_shm_t(),
+          const remote_rma_t &rma = remote_rma_t()
         ) :
-          parent_t(i, distmem_grid_size, single_threaded, thread_rank, thread_size)
+          parent_t(i, distmem_grid_size, thread_rank, thread_size),
+#if defined(USE_MPI)
+          peer(peer),
+          tag_base(4 * (d + n_dims * std::max(thread_rank, 0))), // 4: left/rght data and debug messages
+          shm(shm),
+          rma(rma),
+#endif
+          is_cyclic(is_cyclic)
         {
 #if defined(USE_MPI)
-  
-          const int slice_size = n_dims==1 ? 1 : (n_dims==2? distmem_grid_size[1]+6 : (distmem_grid_size[1]+6) * (distmem_grid_size[2]+6) ); // 3 is the max halo size (?), so 6 on both sides
-//std::cerr << "remote_common ctor, " 
-//  << " distmem_grid_size[0]: " << distmem_grid_size[0]
-//  << " distmem_grid_size[1]: " << distmem_grid_size[1]
-//  << " distmem_grid_size[2]: " << distmem_grid_size[2]
-//  << " slice_size: " << slice_size 
-//  << " halo: " << halo
-//  << std::endl;
-          // allocate enough memory in buffers to store largest halos to be sent
-          buf_send = (real_t *) malloc(halo * slice_size * sizeof(real_t));
-          buf_recv = (real_t *) malloc(halo * slice_size * sizeof(real_t));
+          // exchanging the addresses of the counters with the peer's bcond
+          if (rma.cnt != nullptr)
+          {
+            rma_rank = mpicom.rank();
+            MPI_Get_address(rma.cnt, &rma_cnt_addr);
+            MPI_Irecv(&rma_peer_cnt_addr, 1, MPI_AINT, peer, msg_recv(), mpicom, &rma_addr_reqs[0]);
+            MPI_Isend(&rma_cnt_addr, 1, MPI_AINT, peer, msg_send(), mpicom, &rma_addr_reqs[1]);
+          }
+#endif
+        }
+
+        void batch_begin() override
+        {
+#if defined(USE_MPI)
+          batching = true;
+#endif
+        }
+
+        void batch_start() override
+        {
+#if defined(USE_MPI)
+          batching = false;
+          start_send();
+          start_recv();
+#endif
+        }
+
+        void batch_wait() override
+        {
+#if defined(USE_MPI)
+          wait_send();
+          wait_recv();
 #endif
         }
 
@@ -246,12 +695,29 @@ namespace libmpdataxx
         ~remote_common()
         {
 #if defined(USE_MPI)
-          free(buf_send);
-          free(buf_recv);
+          // MPI might have been finalized by the solver dtor already
+          int finalized;
+          MPI_Finalized(&finalized);
+          if (finalized) return;
+
+          for (auto *reqs : {&send_reqs, &recv_reqs})
+          {
+            for (auto &r : *reqs)
+            {
+              MPI_Request_free(&r.second.req);
+              MPI_Type_free(&r.second.type);
+            }
+          }
+          for (auto &t : part_types) MPI_Type_free(&t.second);
+
+          // the window is freed by distmem, the bconds that are not used completing the exchange of addresses
+          if (rma.cnt != nullptr) rma_wait_addr();
+          for (auto &r : rma_desc_reqs) if (r != MPI_REQUEST_NULL) MPI_Request_free(&r);
+          for (auto &t : rma_targets) MPI_Type_free(&t.type);
+          for (auto &t : rma_origin_types) MPI_Type_free(&t.second);
 #endif
         }
       };
     }
   } // namespace bcond
 } // namespace libmpdataxx
-
@@ -77,10 +77,13 @@ namespace libmpdataxx
         const int i = this->left_edge_sclr;
 
         // if executed first (d=0) this could contain NaNs
+        // with shared-memory tiles in y, zero-out only outside of the whole domain
         if (d == 0)
         {
-          av[d+1](pi<d>(i, (j-h).first())) = 0;
-          av[d+1](pi<d>(i, (j+h).last())) = 0;
+          if (this->thread_rank == 0)
+            av[d+1](pi<d>(i, (j-h).first())) = 0;
+          if (this->thread_rank == this->thread_size - 1)
+            av[d+1](pi<d>(i, (j+h).last())) = 0;
         }
 
         // zero-divergence condition
@@ -170,10 +173,13 @@ namespace libmpdataxx
         const int i = this->rght_edge_sclr;
 
         // if executed first (d=0) this could contain NaNs
+        // with shared-memory tiles in y, zero-out only outside of the whole domain
         if (d == 0)
         {
-          av[d+1](pi<d>(i, (j-h).first())) = 0;
-          av[d+1](pi<d>(i, (j+h).last())) = 0;
+          if (this->thread_rank == 0)
+            av[d+1](pi<d>(i, (j-h).first())) = 0;
+          if (this->thread_rank == this->thread_size - 1)
+            av[d+1](pi<d>(i, (j+h).last())) = 0;
         }
 
         // zero-divergence condition
@@ -18,9 +18,9 @@ namespace libmpdataxx
         dir == left &&
         n_dims == 2
       >::type
-    > : public detail::polar_common<real_t, halo, n_dims>
+    > : public detail::polar_common<real_t, halo, dir, n_dims>
     {
-      using parent_t = detail::polar_common<real_t, halo, n_dims>;
+      using parent_t = detail::polar_common<real_t, halo, dir, n_dims>;
       using arr_t = blitz::Array<real_t, 2>;
       using parent_t::parent_t; // inheriting ctor
 
@@ -30,6 +30,7 @@ namespace libmpdataxx
       void fill_halos_sclr(arr_t &a, const rng_t &j, const bool deriv = false)
       {
         using namespace idxperm;
+        const arr_t &src = this->polar_src(a, this->sclr_src, rng_t(this->left_edge_sclr, this->left_edge_sclr + halo - 1), j);
         for (int i = 0; i < halo; ++i)
         {
           for (int jj = j.first(); jj <= j.last(); jj++)
@@ -37,8 +38,8 @@ namespace libmpdataxx
             a(pi<d>(this->left_halo_sclr.last() - i,
                     jj))
             =
-            a(pi<d>(this->left_edge_sclr + i,
-                    this->polar_neighbours(jj)));
+            src(pi<d>(this->left_edge_sclr + i,
+                    this->src_col(jj)));
 
           }
         }
@@ -50,11 +51,12 @@ namespace libmpdataxx
         if (!ad) av[d](pi<d>(this->left_halo_vctr.last(), j)) = 0;
         if (halo > 1)
         {
+          const arr_t &src = this->polar_src(av[d], this->vctr_alng_src, rng_t(this->left_edge_sclr + h, this->left_edge_sclr + h), j);
           for (int jj = j.first(); jj <= j.last(); jj++)
           {
             av[d](pi<d>(this->left_halo_vctr.first(), jj))
             =
-            av[d](pi<d>(this->left_edge_sclr + h, this->polar_neighbours(jj)));
+            src(pi<d>(this->left_edge_sclr + h, this->src_col(jj)));
           }
         }
       }
@@ -62,6 +64,7 @@ namespace libmpdataxx
       void fill_halos_vctr_nrml(arr_t &a, const rng_t &j)
       {
         using namespace idxperm;
+        const arr_t &src = this->polar_src(a, this->vctr_nrml_src, rng_t(this->left_intr_vctr.last() - (halo - 1), this->left_intr_vctr.last()), j);
         for (int i = 0; i < halo; ++i)
         {
           for (int jj = j.first(); jj <= j.last(); jj++)
@@ -69,8 +72,8 @@ namespace libmpdataxx
             a(pi<d>(this->left_halo_sclr.first() + i,
                     jj + h))
             =
-            a(pi<d>(this->left_intr_vctr.last() - i,
-                    this->polar_neighbours(jj) + h));
+            src(pi<d>(this->left_intr_vctr.last() - i,
+                    this->src_col(jj) + h));
 
           }
         }
@@ -84,9 +87,9 @@ namespace libmpdataxx
         dir == rght &&
         n_dims == 2
       >::type
-    > : public detail::polar_common<real_t, halo, n_dims>
+    > : public detail::polar_common<real_t, halo, dir, n_dims>
     {
-      using parent_t = detail::polar_common<real_t, halo, n_dims>;
+      using parent_t = detail::polar_common<real_t, halo, dir, n_dims>;
       using arr_t = blitz::Array<real_t, 2>;
       using parent_t::parent_t; // inheriting ctor
 
@@ -96,6 +99,7 @@ namespace libmpdataxx
       void fill_halos_sclr(arr_t &a, const rng_t &j, const bool deriv = false)
       {
         using namespace idxperm;
+        const arr_t &src = this->polar_src(a, this->sclr_src, rng_t(this->rght_edge_sclr - halo + 1, this->rght_edge_sclr), j);
 
         for (int i = 0; i < halo; ++i)
         {
@@ -104,8 +108,8 @@ namespace libmpdataxx
             a(pi<d>(this->rght_halo_sclr.first() + i,
                     jj))
             =
-            a(pi<d>(this->rght_edge_sclr - i,
-                    this->polar_neighbours(jj)));
+            src(pi<d>(this->rght_edge_sclr - i,
+                    this->src_col(jj)));
 
           }
         }
@@ -117,11 +121,12 @@ namespace libmpdataxx
         if (!ad) av[d](pi<d>(this->rght_halo_vctr.first(), j)) = 0;
         if (halo > 1)
         {
+          const arr_t &src = this->polar_src(av[d], this->vctr_alng_src, rng_t(this->rght_edge_sclr - h, this->rght_edge_sclr - h), j);
           for (int jj = j.first(); jj <= j.last(); jj++)
           {
             av[d](pi<d>(this->rght_halo_vctr.last(), jj))
             =
-            av[d](pi<d>(this->rght_edge_sclr - h, this->polar_neighbours(jj)));
+            src(pi<d>(this->rght_edge_sclr - h, this->src_col(jj)));
           }
         }
       }
@@ -129,6 +134,7 @@ namespace libmpdataxx
       void fill_halos_vctr_nrml(arr_t &a, const rng_t &j)
       {
         using namespace idxperm;
+        const arr_t &src = this->polar_src(a, this->vctr_nrml_src, rng_t(this->rght_intr_vctr.last() - (halo - 1), this->rght_intr_vctr.last()), j);
         for (int i = 0; i < halo; ++i)
         {
           for (int jj = j.first(); jj <= j.last(); jj++)
@@ -136,8 +142,8 @@ namespace libmpdataxx
             a(pi<d>(this->rght_halo_sclr.first() + i,
                     jj + h))
             =
-            a(pi<d>(this->rght_intr_vctr.last() - i,
-                    this->polar_neighbours(jj) + h));
+            src(pi<d>(this->rght_intr_vctr.last() - i,
+                    this->src_col(jj) + h));
 
           }
         }
@@ -18,9 +18,9 @@ namespace libmpdataxx
         dir == left &&
         n_dims == 3
       >::type
-    > : public detail::polar_common<real_t, halo, n_dims>
+    > : public detail::polar_common<real_t, halo, dir, n_dims>
     {
-      using parent_t = detail::polar_common<real_t, halo, n_dims>;
+      using parent_t = detail::polar_common<real_t, halo, dir, n_dims>;
       using arr_t = blitz::Array<real_t, 3>;
       using parent_t::parent_t; // inheriting ctor
 
@@ -30,13 +30,14 @@ namespace libmpdataxx
       void fill_halos_sclr(arr_t &a, const rng_t &j, const rng_t &k, const bool deriv = false)
       {
         using namespace idxperm;
+        const arr_t &src = this->polar_src(a, this->sclr_src, rng_t(this->left_edge_sclr, this->left_edge_sclr + halo - 1), j, k);
         for (int i = 0; i < halo; ++i)
         {
           for (int jj = j.first(); jj <= j.last(); jj++)
           {
             a(pi<d>(this->left_halo_sclr.last() - i, jj, k))
             =
-            a(pi<d>(this->left_edge_sclr + i, this->polar_neighbours(jj), k));
+            src(pi<d>(this->left_edge_sclr + i, this->src_col(jj), k));
 
           }
         }
@@ -48,11 +49,12 @@ namespace libmpdataxx
         if (!ad) av[d](pi<d>(this->left_halo_vctr.last(), j, k)) = 0;
         if (halo > 1)
         {
+          const arr_t &src = this->polar_src(av[d], this->vctr_alng_src, rng_t(this->left_edge_sclr + h, this->left_edge_sclr + h), j, k);
           for (int jj = j.first(); jj <= j.last(); jj++)
           {
             av[d](pi<d>(this->left_halo_vctr.first(), jj, k))
             =
-            av[d](pi<d>(this->left_edge_sclr + h, this->polar_neighbours(jj), k));
+            src(pi<d>(this->left_edge_sclr + h, this->src_col(jj), k));
           }
         }
       }
@@ -60,13 +62,14 @@ namespace libmpdataxx
       void fill_halos_vctr_nrml(arr_t &a, const rng_t &j, const rng_t &k)
       {
         using namespace idxperm;
+        const arr_t &src = this->polar_src(a, this->vctr_nrml_src, rng_t(this->left_intr_vctr.last() - (halo - 1), this->left_intr_vctr.last()), j, k);
         for (int i = 0; i < halo; ++i)
         {
           for (int jj = j.first(); jj <= j.last(); jj++)
           {
             a(pi<d>(this->left_halo_sclr.first() + i, jj + h, k))
             =
-            a(pi<d>(this->left_intr_vctr.last() - i, this->polar_neighbours(jj) + h, k));
+            src(pi<d>(this->left_intr_vctr.last() - i, this->src_col(jj) + h, k));
           }
         }
       }
@@ -79,9 +82,9 @@ namespace libmpdataxx
         dir == rght &&
         n_dims == 3
       >::type
-    > : public detail::polar_common<real_t, halo, n_dims>
+    > : public detail::polar_common<real_t, halo, dir, n_dims>
     {
-      using parent_t = detail::polar_common<real_t, halo, n_dims>;
+      using parent_t = detail::polar_common<real_t, halo, dir, n_dims>;
       using arr_t = blitz::Array<real_t, 3>;
       using parent_t::parent_t; // inheriting ctor
 
@@ -91,6 +94,7 @@ namespace libmpdataxx
       void fill_halos_sclr(arr_t &a, const rng_t &j, const rng_t &k, const bool deriv = false)
       {
         using namespace idxperm;
+        const arr_t &src = this->polar_src(a, this->sclr_src, rng_t(this->rght_edge_sclr - halo + 1, this->rght_edge_sclr), j, k);
 
         for (int i = 0; i < halo; ++i)
         {
@@ -98,7 +102,7 @@ namespace libmpdataxx
           {
             a(pi<d>(this->rght_halo_sclr.first() + i, jj, k))
             =
-            a(pi<d>(this->rght_edge_sclr - i, this->polar_neighbours(jj), k));
+            src(pi<d>(this->rght_edge_sclr - i, this->src_col(jj), k));
           }
         }
       }
@@ -109,11 +113,12 @@ namespace libmpdataxx
         if (!ad) av[d](pi<d>(this->rght_halo_vctr.first(), j, k)) = 0;
         if (halo > 1)
         {
+          const arr_t &src = this->polar_src(av[d], this->vctr_alng_src, rng_t(this->rght_edge_sclr - h, this->rght_edge_sclr - h), j, k);
           for (int jj = j.first(); jj <= j.last(); jj++)
           {
             av[d](pi<d>(this->rght_halo_vctr.last(), jj, k))
             =
-            av[d](pi<d>(this->rght_edge_sclr - h, this->polar_neighbours(jj), k));
+            src(pi<d>(this->rght_edge_sclr - h, this->src_col(jj), k));
           }
         }
       }
@@ -121,13 +126,14 @@ namespace libmpdataxx
       void fill_halos_vctr_nrml(arr_t &a, const rng_t &j,  const rng_t &k)
       {
         using namespace idxperm;
+        const arr_t &src = this->polar_src(a, this->vctr_nrml_src, rng_t(this->rght_intr_vctr.last() - (halo - 1), this->rght_intr_vctr.last()), j, k);
         for (int i = 0; i < halo; ++i)
         {
           for (int jj = j.first(); jj <= j.last(); jj++)
           {
             a(pi<d>(this->rght_halo_sclr.first() + i, jj + h, k))
             =
-            a(pi<d>(this->rght_intr_vctr.last() - i, this->polar_neighbours(jj) + h, k));
+            src(pi<d>(this->rght_intr_vctr.last() - i, this->src_col(jj) + h, k));
           }
         }
       }
@@ -18,9 +18,9 @@ namespace libmpdataxx
         dir == left   &&
         n_dims == 1
       >::type
-    > : public detail::remote_common<real_t, halo, dir, n_dims>
+    > : public detail::remote_common<real_t, halo, dir, n_dims, dim>
     {
-      using parent_t = detail::remote_common<real_t, halo, dir, n_dims>;
+      using parent_t = detail::remote_common<real_t, halo, dir, n_dims, dim>;
       using arr_t = typename parent_t::arr_t;
       using idx_t = typename parent_t::idx_t;
       using idx_ctor_arg_t = blitz::TinyVector<rng_t, n_dims>;
@@ -137,9 +137,9 @@ namespace libmpdataxx
         dir == rght   &&
         n_dims == 1
       >::type
-    > : public detail::remote_common<real_t, halo, dir, n_dims>
+    > : public detail::remote_common<real_t, halo, dir, n_dims, dim>
     {
-      using parent_t = detail::remote_common<real_t, halo, dir, n_dims>;
+      using parent_t = detail::remote_common<real_t, halo, dir, n_dims, dim>;
       using arr_t = typename parent_t::arr_t;
       using idx_t = typename parent_t::idx_t;
       using idx_ctor_arg_t = blitz::TinyVector<rng_t, n_dims>;
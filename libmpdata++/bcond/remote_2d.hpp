@@ -18,9 +18,9 @@ namespace libmpdataxx
         dir == left   &&
         n_dims == 2
       >::type
-    > : public detail::remote_common<real_t, halo, dir, n_dims>
+    > : public detail::remote_common<real_t, halo, dir, n_dims, d>
     {
-      using parent_t = detail::remote_common<real_t, halo, dir, n_dims>;
+      using parent_t = detail::remote_common<real_t, halo, dir, n_dims, d>;
       using arr_t = blitz::Array<real_t, 2>;
       using parent_t::parent_t; // inheriting ctor
 
@@ -51,13 +51,13 @@ namespace libmpdataxx
         {
           if(halo == 1)
             // send vectors to the left of the domain
-            this->send(av[0], pi<d>(this->left_intr_vctr + off, j));
+            this->send(av[d], pi<d>(this->left_intr_vctr + off, j));
           else
             // receive the halo without the rightmost column, which was caluclated by this process
-            this->xchng(av[0], pi<d>(this->left_intr_vctr + off, j), pi<d>((this->left_halo_vctr^h)^(-1), j));
+            this->xchng(av[d], pi<d>(this->left_intr_vctr + off, j), pi<d>((this->left_halo_vctr^h)^(-1), j));
         }
         else
-          this->xchng(av[0], pi<d>(this->left_intr_vctr + off, j), pi<d>(this->left_halo_vctr, j));
+          this->xchng(av[d], pi<d>(this->left_intr_vctr + off, j), pi<d>(this->left_halo_vctr, j));
       }
 
       void fill_halos_sgs_div(arr_t &a, const rng_t &j)
@@ -78,13 +78,13 @@ namespace libmpdataxx
         {
           if(halo == 1)
             // send vectors to the left of the domain
-            this->send(av[0 + offset], pi<d>(this->left_intr_vctr + off, j));
+            this->send(av[d + offset], pi<d>(this->left_intr_vctr + off, j));
           else
             // receive the halo without the rightmost column, which was caluclated by this process
-            this->xchng(av[0 + offset], pi<d>(this->left_intr_vctr + off, j), pi<d>((this->left_halo_vctr^h)^(-1), j));
+            this->xchng(av[d + offset], pi<d>(this->left_intr_vctr + off, j), pi<d>((this->left_halo_vctr^h)^(-1), j));
         }
         else
-          this->xchng(av[0 + offset], pi<d>(this->left_intr_vctr + off, j), pi<d>(this->left_halo_vctr, j));
+          this->xchng(av[d + offset], pi<d>(this->left_intr_vctr + off, j), pi<d>(this->left_halo_vctr, j));
       }
 
       void fill_halos_sgs_tnsr(arrvec_t<arr_t> &av, const arr_t &, const arr_t &, const rng_t &j, const real_t)
@@ -136,9 +136,9 @@ namespace libmpdataxx
         dir == rght   &&
         n_dims == 2
       >::type
-    > : public detail::remote_common<real_t, halo, dir, n_dims>
+    > : public detail::remote_common<real_t, halo, dir, n_dims, d>
     {
-      using parent_t = detail::remote_common<real_t, halo, dir, n_dims>;
+      using parent_t = detail::remote_common<real_t, halo, dir, n_dims, d>;
       using arr_t = blitz::Array<real_t, 2>;
       using parent_t::parent_t; // inheriting ctor
 
@@ -168,13 +168,13 @@ namespace libmpdataxx
         {
           if(halo == 1)
             //receive the halo
-            this->recv(av[0], pi<d>(this->rght_halo_vctr, j));
+            this->recv(av[d], pi<d>(this->rght_halo_vctr, j));
           else
             // don't send the first column to the right of the domain, it will be calculated and sent here by the process to the right
-            this->xchng(av[0], pi<d>(((this->rght_intr_vctr + off)^h)^(-1), j), pi<d>(this->rght_halo_vctr, j));
+            this->xchng(av[d], pi<d>(((this->rght_intr_vctr + off)^h)^(-1), j), pi<d>(this->rght_halo_vctr, j));
         }
         else
-          this->xchng(av[0], pi<d>(this->rght_intr_vctr + off, j), pi<d>(this->rght_halo_vctr, j));
+          this->xchng(av[d], pi<d>(this->rght_intr_vctr + off, j), pi<d>(this->rght_halo_vctr, j));
       }
 
       void fill_halos_sgs_div(arr_t &a, const rng_t &j)
@@ -195,13 +195,13 @@ namespace libmpdataxx
         {
           if(halo == 1)
             //receive the halo
-            this->recv(av[0 + offset], pi<d>(this->rght_halo_vctr, j));
+            this->recv(av[d + offset], pi<d>(this->rght_halo_vctr, j));
           else
             // don't send the first column to the right of the domain, it will be calculated and sent here by the process to the right
-            this->xchng(av[0 + offset], pi<d>(((this->rght_intr_vctr + off)^h)^(-1), j), pi<d>(this->rght_halo_vctr, j));
+            this->xchng(av[d + offset], pi<d>(((this->rght_intr_vctr + off)^h)^(-1), j), pi<d>(this->rght_halo_vctr, j));
         }
         else
-          this->xchng(av[0 + offset], pi<d>(this->rght_intr_vctr + off, j), pi<d>(this->rght_halo_vctr, j));
+          this->xchng(av[d + offset], pi<d>(this->rght_intr_vctr + off, j), pi<d>(this->rght_halo_vctr, j));
       }
 
       void fill_halos_sgs_tnsr(arrvec_t<arr_t> &av, const arr_t &, const arr_t &, const rng_t &j, const real_t)
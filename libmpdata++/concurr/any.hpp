@@ -8,6 +8,8 @@
 
 #include <libmpdata++/blitz.hpp>
 
+#include <functional>
+
 namespace libmpdataxx
 {
   namespace concurr
@@ -27,10 +29,53 @@ namespace libmpdataxx
       const blitz::Array<real_t, n_dims> advectee_global(int eqn = 0)
       { assert(false); throw; }
 
+      // as above, but returned only on the process of rank root (empty array on the others),
+      // avoiding a copy of the whole domain on each process
+      virtual
+      const blitz::Array<real_t, n_dims> advectee_global_gather(int eqn = 0, int root = 0)
+      { assert(false); throw; }
+
+      // part of an advectee within box (in global indices, e.g. a single plane),
+      // on all processes if root < 0; the result is indexed globally, collective
+      virtual
+      const blitz::Array<real_t, n_dims> advectee_global_slice(const idx_t<n_dims> &box, int eqn = 0, int root = -1)
+      { assert(false); throw; }
+
+      // calls fun on the process of rank root (on all if root < 0) with consecutive chunks
+      // of an advectee made of chunk x-planes, so that memory use does not depend on the grid size; collective
+      virtual
+      void advectee_global_chunks(const std::function<void(const blitz::Array<real_t, n_dims> &)> &fun, int eqn = 0, int chunk = 1, int root = 0)
+      { assert(false); throw; }
+
       virtual
       void advectee_global_set(const blitz::Array<real_t, n_dims>, int eqn = 0)
       { assert(false); throw; }
 
+      // initialisation with a function of global indices evaluated over the local part of the domain
+      // by all threads in parallel (each over its own subdomain), without any global-sized array;
+      // the indices are those of the arrays returned by the respective accessors below (e.g. advector())
+      using init_fun_t = std::function<real_t(const blitz::TinyVector<int, n_dims> &)>;
+
+      virtual
+      void advectee_init(const init_fun_t &, int eqn = 0)
+      { assert(false); throw; }
+
+      virtual
+      void advector_init(const init_fun_t &, int dim = 0)
+      { assert(false); throw; }
+
+      virtual
+      void g_factor_init(const init_fun_t &)
+      { assert(false); throw; }
+
+      virtual
+      void vab_coefficient_init(const init_fun_t &)
+      { assert(false); throw; }
+
+      virtual
+      void vab_relaxed_state_init(const init_fun_t &, int d = 0)
+      { assert(false); throw; }
+
       virtual
       blitz::Array<real_t, n_dims> advector(int dim = 0)
       { assert(false); throw; }
@@ -7,6 +7,8 @@
 #pragma once
 
 #include <libmpdata++/concurr/detail/concurr_common.hpp>
+#include <libmpdata++/concurr/detail/thread_pool.hpp>
+#include <libmpdata++/concurr/detail/spin_barrier.hpp>
 
 #include <thread>
 #include <mutex>
@@ -75,6 +77,7 @@ namespace libmpdataxx
       class mem_t : public parent_t::mem_t
       {
         detail::barrier b;
+        std::unique_ptr<detail::spin_barrier> sb; // used instead of b if barrier_spin > 0
 
         public:
 
@@ -92,35 +95,53 @@ namespace libmpdataxx
         }
 
         // ctor
-        mem_t(const std::array<int, solver_t::n_dims> &grid_size) :
-          b(size(grid_size[0])),
-          parent_t::mem_t(grid_size, size(grid_size[0]))
-        {};
+        mem_t(const std::array<int, solver_t::n_dims> &grid_size, const int barrier_spin = 0, const int mpi_decomp_dims = 1) :
+          b(size(parent_t::mem_t::max_size(grid_size))),
+          parent_t::mem_t(grid_size, size(parent_t::mem_t::max_size(grid_size)), mpi_decomp_dims)
+        {
+          if (barrier_spin > 0) sb.reset(new detail::spin_barrier(size(parent_t::mem_t::max_size(grid_size)), barrier_spin));
+        };
 
         void barrier()
         {
-          b.wait();
+          const typename parent_t::mem_t::wait_timer wt(this->time_barriers);
+          if (sb) sb->wait();
+          else b.wait();
         }
       };
 
+      std::unique_ptr<detail::thread_pool<std::thread>> pool;
+
       public:
 
       void solve(typename parent_t::advance_arg_t nt)
       {
-        boost::ptr_vector<std::thread> threads(mem_t::size());
-        for (int i = 0; i < this->algos.size(); ++i)
+        parallel([&](const int i) { this->algos[i].solve(nt); });
+      }
+
+      void parallel(const std::function<void(int)> &job)
+      {
+        if (pool)
         {
-          threads.push_back(new std::thread(
-            &solver_t::solve, &(this->algos[i]), nt
-          ));
+          pool->run(job); // the workers pinned once when started
+          return;
         }
+
+        const auto pinned_job = [&](const int i) { this->aff.pin(i); job(i); };
+
+        boost::ptr_vector<std::thread> threads(mem_t::size());
+        for (int i = 0; i < this->algos.size(); ++i)
+          threads.push_back(new std::thread(pinned_job, i));
         for (auto &th : threads) th.join();
       }
 
       // ctor
       cxx11_thread(const typename solver_t::rt_params_t &p) :
-        parent_t(p, new mem_t(p.grid_size), mem_t::size(p.grid_size[solver_t::n_dims < 3 ? 0 : 1])) // note 3D domain decomposition in y direction
-      {}
+        parent_t(p, new mem_t(p.grid_size, p.barrier_spin, p.mpi_decomp_dims), mem_t::size(mem_t::max_size(p.grid_size)))
+      {
+        if (p.thread_pool) pool.reset(new detail::thread_pool<std::thread>(this->algos.size(), [this](const int i) { this->aff.pin(i); }));
+        this->numa_init(p);
+      }
 
     };
   } // namespace concurr
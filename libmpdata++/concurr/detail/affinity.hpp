@@ -0,0 +1,209 @@
+/** @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+namespace libmpdataxx
+{
+  namespace concurr
+  {
+    namespace detail
+    {
+      // pinning of threads to CPUs according to a policy given as a string:
+      // - ""        no pinning (default)
+      // - "compact" thread i on the i-th CPU available to the process
+      // - "scatter" threads distributed round-robin over sockets
+      // - a list of places in the OMP_PLACES syntax, e.g. "{0,1},{2,3}", "{0:4}:4:4" or "0,2,4,6",
+      //   thread i pinned to the CPUs of place i (modulo the number of places)
+      class affinity
+      {
+        std::vector<std::vector<int>> places;
+
+        static std::vector<int> available_cpus()
+        {
+          std::vector<int> cpus;
+#if defined(__linux__)
+          cpu_set_t set;
+          CPU_ZERO(&set);
+          if (sched_getaffinity(0, sizeof(set), &set) == 0)
+            for (int c = 0; c < CPU_SETSIZE; ++c)
+              if (CPU_ISSET(c, &set)) cpus.push_back(c);
+#endif
+          return cpus;
+        }
+
+        static int socket(const int cpu)
+        {
+          std::ifstream f("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/physical_package_id");
+          int id = 0;
+          if (!(f >> id)) id = 0;
+          return id;
+        }
+
+        static int parse_int(const std::string &s)
+        {
+          std::size_t pos;
+          const int ret = std::stoi(s, &pos);
+          if (pos != s.size() || ret < 0) throw std::invalid_argument(s);
+          return ret;
+        }
+
+        // "lower[:length[:stride]]"
+        static std::vector<int> parse_interval(const std::string &s)
+        {
+          std::vector<int> nums;
+          std::istringstream ss(s);
+          for (std::string tok; std::getline(ss, tok, ':');) nums.push_back(parse_int(tok));
+          if (nums.empty() || nums.size() > 3) throw std::invalid_argument(s);
+
+          std::vector<int> ret;
+          const int len = nums.size() > 1 ? nums[1] : 1, stride = nums.size() > 2 ? nums[2] : 1;
+          for (int i = 0; i < len; ++i) ret.push_back(nums[0] + i * stride);
+          return ret;
+        }
+
+        static std::vector<std::vector<int>> parse_places(const std::string &str)
+        {
+          std::vector<std::vector<int>> ret;
+          std::size_t pos = 0;
+          while (pos < str.size())
+          {
+            std::vector<int> place;
+            std::size_t end;
+            if (str[pos] == '{')
+            {
+              const std::size_t close = str.find('}', pos);
+              if (close == std::string::npos) throw std::invalid_argument(str);
+              std::istringstream ss(str.substr(pos + 1, close - pos - 1));
+              for (std::string tok; std::getline(ss, tok, ',');)
+                for (const int c : parse_interval(tok)) place.push_back(c);
+
+              // optional ":length[:stride]" replicating the place with a shift
+              end = std::min(str.find(',', close), str.size());
+              std::vector<int> rep = {0, 1, int(place.size())};
+              if (close + 1 < end)
+              {
+                if (str[close + 1] != ':') throw std::invalid_argument(str);
+                std::istringstream rs(str.substr(close + 2, end - close - 2));
+                int n = 1;
+                for (std::string tok; std::getline(rs, tok, ':'); ++n)
+                {
+                  if (n > 2) throw std::invalid_argument(str);
+                  rep[n] = parse_int(tok);
+                }
+              }
+              for (int r = 0; r < rep[1]; ++r)
+              {
+                ret.push_back(place);
+                for (auto &c : ret.back()) c += r * rep[2];
+              }
+            }
+            else
+            {
+              end = std::min(str.find(',', pos), str.size());
+              for (const int c : parse_interval(str.substr(pos, end - pos)))
+                ret.push_back({c});
+            }
+            pos = end + 1;
+          }
+          if (ret.empty()) throw std::invalid_argument(str);
+          return ret;
+        }
+
+        public:
+
+        // ctor
+        affinity(const std::string &policy)
+        {
+          if (policy.empty()) return;
+
+#if !defined(__linux__)
+          throw std::runtime_error("libmpdata++: thread affinity is supported on Linux only");
+#endif
+
+          const std::vector<int> cpus = available_cpus();
+          if (cpus.empty())
+            throw std::runtime_error("libmpdata++: failed to get the list of available CPUs");
+
+          if (policy == "compact")
+          {
+            for (const int c : cpus) places.push_back({c});
+          }
+          else if (policy == "scatter")
+          {
+            std::map<int, std::vector<int>> per_socket;
+            for (const int c : cpus) per_socket[socket(c)].push_back(c);
+            for (std::size_t i = 0; places.size() < cpus.size(); ++i)
+              for (const auto &s : per_socket)
+                if (i < s.second.size()) places.push_back({s.second[i]});
+          }
+          else
+          {
+            try
+            {
+              places = parse_places(policy);
+            }
+            catch (const std::logic_error &)
+            {
+              throw std::runtime_error("libmpdata++: invalid thread affinity policy: " + policy);
+            }
+          }
+        }
+
+        bool enabled() const
+        {
+          return !places.empty();
+        }
+
+        const std::vector<int> &place(const int rank) const
+        {
+          return places.at(rank % places.size());
+        }
+
+        // to be called from within the thread of a given rank
+        void pin(const int rank) const
+        {
+          if (!enabled()) return;
+#if defined(__linux__)
+          cpu_set_t set;
+          CPU_ZERO(&set);
+          for (const int c : place(rank)) if (c < CPU_SETSIZE) CPU_SET(c, &set);
+          pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+        }
+
+        void print(const int size) const
+        {
+          if (!enabled()) return;
+          std::ostringstream tmp;
+          tmp << "libmpdata++: thread placement:";
+          for (int r = 0; r < size; ++r)
+          {
+            tmp << " " << r << "->{";
+            for (std::size_t i = 0; i < place(r).size(); ++i)
+              tmp << (i ? "," : "") << place(r)[i];
+            tmp << "}";
+          }
+          std::cerr << tmp.str() << std::endl;
+        }
+      };
+    } // namespace detail
+  } // namespace concurr
+} // namespace libmpdataxx
@@ -16,6 +16,7 @@
 
 #include <libmpdata++/concurr/detail/sharedmem.hpp>
 #include <libmpdata++/concurr/detail/timer.hpp>
+#include <libmpdata++/concurr/detail/affinity.hpp>
 #include <libmpdata++/concurr/any.hpp>
 
 #include <libmpdata++/bcond/shared.hpp>
@@ -34,72 +35,18 @@
 #include <libmpdata++/bcond/remote_3d.hpp>
 #include <libmpdata++/bcond/gndsky_3d.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <numeric>
+
 namespace libmpdataxx
 {
   namespace concurr
   {
     namespace detail
     {
-      // helpers for setting remote bcond
-      template <
-        class real_t,
-        bcond::drctn_e dir,
-        int dim,
-        int n_dims,
-        int halo,
-        class bcp_t,
-        class mem_t
-      >
-      struct bc_set_remote_impl
-      {
-        static void _(
-          bcp_t &bcp,
-          const std::unique_ptr<mem_t> &mem,
-          const int thread_rank,
-          const int thread_size
-        )
-        {
-          bcp.reset(
-            new bcond::bcond<real_t, halo, bcond::remote, dir, n_dims, dim>(
-              mem->slab(mem->grid_size[dim]),
-              mem->distmem.grid_size,
-              thread_rank,
-              thread_size
-            )
-          );
-        }
-      };
-
-      // 3d specialization
-      template <
-        class real_t,
-        bcond::drctn_e dir,
-        int dim,
-        int halo,
-        class bcp_t,
-        class mem_t
-      >
-      struct bc_set_remote_impl<real_t, dir, dim, 3, halo, bcp_t, mem_t>
-      {
-        static void _(
-          bcp_t &bcp,
-          const std::unique_ptr<mem_t> &mem,
-          const int thread_rank,
-          const int thread_size
-        )
-        {
-          bcp.reset(
-            new bcond::bcond<real_t, halo, bcond::remote, dir, 3, dim>(
-              mem->slab(mem->grid_size[dim]),
-              mem->distmem.grid_size,
-              mem->slab(mem->grid_size[1], thread_rank, thread_size), // NOTE: we assume here remote 3d bcond is only on the edges perpendicular to x
-              thread_rank,
-              thread_size
-            )
-          );
-        }
-      };
-
+      // helper for setting remote bcond, each thread exchanging its own part of the edge
       template <
         class real_t,
         bcond::drctn_e dir,
@@ -112,11 +59,26 @@ namespace libmpdataxx
       void bc_set_remote(
         bcp_t &bcp,
         const std::unique_ptr<mem_t> &mem,
+        const int peer,
+        const bool is_cyclic,
         const int thread_rank,
-        const int thread_size
+        const int thread_size,
+        const bcond::detail::remote_shm_t &shm,
+        const bcond::detail::remote_rma_t &rma
       )
       {
-        bc_set_remote_impl<real_t, dir, dim, n_dims, halo, bcp_t, mem_t>::_(bcp, mem, thread_rank, thread_size);
+        bcp.reset(
+          new bcond::bcond<real_t, halo, bcond::remote, dir, n_dims, dim>(
+            mem->slab(mem->grid_size[dim]),
+            mem->distmem.grid_size,
+            peer,
+            is_cyclic,
+            thread_rank,
+            thread_size,
+            shm,
+            rma
+          )
+        );
       }
 
       template<
@@ -160,6 +122,33 @@ namespace libmpdataxx
         boost::ptr_vector<solver_t> algos;
         std::unique_ptr<mem_t> mem;
         timer tmr;
+        affinity aff; // pinning of threads to CPUs, applied by the threaded backends
+
+        // measured load rebalancing of the slab boundaries (see advance())
+        int rebalance_window = 0, rebalance_steps = 0;
+        std::vector<double> work; // per-thread wall time excluding barrier waits since the last rebalancing
+        std::vector<rng_t> slabs; // per-thread ranges in shmem_decomp_dim
+
+        // layout of the shared memory window for exchanges with node-local peers (see shm_setup()):
+        // offset of the slots of each dimension (-1 if not used)
+        std::array<std::ptrdiff_t, solver_t::n_dims> shm_offset;
+
+        // with rt_params_t::mpi_shm, the arrays are allocated in memory shared by the processes
+        // on the node (see sharedmem::old()) and each process provides a slot in which the peers
+        // announce every message its remote bconds send (per dimension split among processes,
+        // thread and direction), the same layout in all processes letting peers find the slots
+        void shm_setup(const int size)
+        {
+          const std::size_t slot = bcond::detail::remote_shm_t::slot_bytes(solver_t::n_dims);
+          std::size_t bytes = 0;
+          for (int d = 0; d < solver_t::n_dims; ++d)
+          {
+            if (mem->distmem.cart_dims[d] == 1) continue;
+            shm_offset[d] = bytes;
+            bytes += 2 * size * slot;
+          }
+          mem->distmem.shm_alloc(bytes);
+        }
 
         public:
 
@@ -177,17 +166,73 @@ namespace libmpdataxx
           const typename solver_t::rt_params_t &p,
           mem_t *mem_p,
           const int &size
-        ) {
+        ) :
+          aff(p.affinity)
+        {
+          aff.print(size);
+
           // allocate the memory to be shared by multiple threads
           mem.reset(mem_p);
+          mem->numa_alloc = p.numa_alloc;
+          mem->n_scratch = p.eqn_overlap && solver_t::n_eqns > 1 ? 2 : 1;
+          mem->shm_arrays = p.mpi_shm && mem->distmem.size() > 1;
           solver_t::alloc(mem.get(), p.n_iters);
+          shm_offset.fill(-1);
+          if (mem->shm_arrays) shm_setup(size);
 
           // allocate per-thread structures
-          init(p, mem->grid_size, size);
+          assert(size == mem->tiles[0] * mem->tiles[1]);
+          init(p, mem->grid_size, mem->tiles[0], mem->tiles[1]); // 2D: x-slabs split in y, 3D: y-slabs split in x
+
+          // neighbour-only synchronisation of halo exchanges, unless some subdomain could read
+          // halo data from beyond its neighbours: polar and custom bconds, 2D tiles
+          // or subdomains narrower than the halo
+          const int d = mem->shmem_decomp_dim;
+          mem->nbr_sync = p.nbr_sync
+            && !has_bcond(bcond::polar) && !has_bcond(bcond::custom)
+            && mem->tiles[1] == 1
+            && mem->grid_size[d].length() / size >= solver_t::halo;
+
+          // split-phase exchange of advectee halos in 3D advop() (see solver_3d::xchng_begin()), only with
+          // remote bconds in x alone as the y and z halos are filled before the x ones, and with
+          // subdomains wide enough to have x columns whose stencils do not reach the x halos
+          if constexpr (solver_t::n_dims == 3)
+            mem->xchng_overlap = p.mpi_overlap
+              && mem->distmem.cart_dims[0] > 1 && mem->distmem.cart_dims[1] == 1
+              && !has_bcond(bcond::custom)
+              && mem->grid_size[0].length() > 2 * solver_t::halo;
+
+          // temporal blocking (see mpdata_common) uses the halos filled once per block of time steps for all
+          // its iterations, valid only if they hold neighbouring (periodic or other processes') data
+          if (p.time_block > 1 && !only_bcond(bcond::cyclic))
+            throw std::runtime_error("libmpdata++: time_block requires cyclic boundary conditions");
+
+          // rebalancing only with slabs and not with MPI: remote bconds along the shared-memory slabs
+          // (2D y edges, 3D x edges) need the same slabs in neighbouring processes
+          if (p.rebalance > 0 && size > 1 && mem->tiles[1] == 1 && mem->distmem.size() == 1)
+          {
+            rebalance_window = p.rebalance;
+            work.assign(size, 0);
+            for (int r = 0; r < size; ++r)
+              slabs.push_back(mem->slab(mem->grid_size[d], r, size));
+            mem->time_barriers = true;
+          }
         }
 
         private:
 
+        static constexpr bool has_bcond(const bcond::bcond_e type)
+        {
+          return bcxl == type || bcxr == type || bcyl == type || bcyr == type || bczl == type || bczr == type;
+        }
+
+        static constexpr bool only_bcond(const bcond::bcond_e type)
+        {
+          for (const auto bc : {bcxl, bcxr, bcyl, bcyr, bczl, bczr})
+            if (bc != type && bc != bcond::null) return false;
+          return true;
+        }
+
         template <
           bcond::bcond_e type,
           bcond::drctn_e dir,
@@ -195,48 +240,110 @@ namespace libmpdataxx
         >
         void bc_set(
           typename solver_t::bcp_t &bcp,
-          const int thread_rank  = 0, // required only by 3D remote (MPI) and open bconds
-          const int thread_size = 0  // required only by 3D remote (MPI) and open bconds
+          const int thread_rank  = 0, // required only by remote (MPI) and 2D/3D open bconds
+          const int thread_size = 1  // required only by remote (MPI) and 2D/3D open bconds
         )
         {
-          // sanity check - polar coords do not work with MPI yet
-          if (type == bcond::polar && mem->distmem.size() > 1)
-            throw std::runtime_error("libmpdata++: Polar boundary conditions do not work with MPI.");
-
-          // distmem overrides
-          if (mem->distmem.size() > 1 && dim == 0)
+          // distmem overrides, in each dimension split among processes
+          if (mem->distmem.cart_dims[dim] > 1)
           {
+            const int
+              coord = mem->distmem.cart_coords[dim],
+              n_coords = mem->distmem.cart_dims[dim];
+            const bool domain_edge =
+              (dir == bcond::left && coord == 0) ||
+              (dir == bcond::rght && coord == n_coords - 1);
+
             if (
               // distmem domain interior
-              (dir == bcond::left && mem->distmem.rank() > 0)
+              !domain_edge
               ||
-              (dir == bcond::rght && mem->distmem.rank() != mem->distmem.size() - 1)
               // cyclic condition for distmem domain (note: will not work if a non-cyclic condition is on the other end)
-              ||
               (type == bcond::cyclic)
             )
             {
+              // shared memory slots of the message sent by this bcond and of the one it receives
+              // (sent by the same thread of the peer in the opposite direction), the arrays of both processes
+              const int peer = mem->distmem.peers[dim][dir];
+              bcond::detail::remote_shm_t shm;
+              if (shm_offset[dim] >= 0 && mem->distmem.node_local(peer))
+              {
+                const std::size_t slot_bytes = bcond::detail::remote_shm_t::slot_bytes(solver_t::n_dims);
+                const auto slot = [&](const int r, const int msg_dir) {
+                  return mem->distmem.shm_base(r) + shm_offset[dim] + (2 * std::max(thread_rank, 0) + msg_dir) * slot_bytes;
+                };
+                shm.send = slot(mem->distmem.rank(), dir);
+                shm.recv = slot(peer, dir == bcond::left ? bcond::rght : bcond::left);
+                shm.arrs = mem->distmem.shm_arrs();
+                shm.peer_arrs = mem->distmem.shm_arrs(peer);
+              }
+
+              // halos put directly into the arrays of the peer, with counters of this bcond in the window of the process
+              bcond::detail::remote_rma_t rma;
+#if defined(USE_MPI) && defined(LIBMPDATAXX_MPI_RMA)
+              rma.win = mem->distmem.rma_window();
+              rma.cnt = mem->distmem.rma_counters();
+#endif
+
               // bc allocation, all mpi routines called by the remote bcnd ctor are thread-safe (?)
               bc_set_remote<real_t, dir, dim, solver_t::n_dims, solver_t::halo>(
                 bcp,
                 mem,
+                peer,
+                domain_edge,
                 thread_rank,
-                thread_size
+                thread_size,
+                shm,
+                rma
               );
               return;
             }
           }
 
-          // 3d open bcond needs to know thread rank and size, because it zeroes perpendicular vectors
-          if (type == bcond::open && solver_t::n_dims == 3)
+          // polar bconds (along x) with x split among processes exchange the rows next to the pole
+          // with the processes along the same edge, each thread for its x slab (see polar_common)
+          if constexpr (type == bcond::polar) if (mem->distmem.cart_dims[0] > 1)
           {
+            if (dim != 1)
+              throw std::runtime_error("libmpdata++: with processes split in x, polar boundary conditions work in y only");
+
+            bcond::detail::polar_peers_t peers;
+            auto coords = mem->distmem.cart_coords;
+            for (coords[0] = 0; coords[0] < mem->distmem.cart_dims[0]; ++coords[0])
+            {
+              peers.ranks.push_back(mem->distmem.cart_rank(coords));
+              peers.slabs.push_back(mem->distmem.cart_slab(0, coords[0]));
+            }
+            peers.coord = mem->distmem.cart_coords[0];
+
             bcp.reset(
               new bcond::bcond<real_t, solver_t::halo, type, dir, solver_t::n_dims, dim>(
                 mem->slab(mem->grid_size[dim]),
                 mem->distmem.grid_size,
-                false,
                 thread_rank,
-                thread_size
+                thread_size,
+                peers
+              )
+            );
+            return;
+          }
+
+          // 2d and 3d open bcond needs to know thread rank and size, because it zeroes perpendicular vectors
+          if (type == bcond::open && solver_t::n_dims > 1)
+          {
+            // x edges with processes split in y: thread rank and size counted among
+            // the threads of all processes along y, so that only the whole domain edges are zeroed
+            const int
+              pd = std::min(1, solver_t::n_dims - 1),
+              prev = dim == 0 && mem->distmem.cart_coords[pd] > 0,
+              next = dim == 0 && mem->distmem.cart_coords[pd] < mem->distmem.cart_dims[pd] - 1;
+
+            bcp.reset(
+              new bcond::bcond<real_t, solver_t::halo, type, dir, solver_t::n_dims, dim>(
+                mem->slab(mem->grid_size[dim]),
+                mem->distmem.grid_size,
+                thread_rank + prev,
+                thread_size + prev + next
               )
             );
             return;
@@ -254,7 +361,7 @@ namespace libmpdataxx
         // 1D version
         void init(
           const typename solver_t::rt_params_t &p,
-          const std::array<rng_t, 1> &grid_size, const int &n0
+          const std::array<rng_t, 1> &grid_size, const int &n0, const int & = 1 // no tiles in 1D
         )
         {
           typename solver_t::bcp_t bxl, bxr, shrdl, shrdr;
@@ -294,26 +401,33 @@ namespace libmpdataxx
           {
             for (int i1 = 0; i1 < n1; ++i1)
             {
-              typename solver_t::bcp_t bxl, bxr, byl, byr, shrdl, shrdr;
+              typename solver_t::bcp_t bxl, bxr, byl, byr, shrdxl, shrdxr, shrdyl, shrdyr;
 
-              // NOTE: for remote bcond, thread_rank set to 0 on purpose in 2D to have propre left/right message tags 
-              bc_set<bcxl, bcond::left, 0>(bxl);
-              bc_set<bcxr, bcond::rght, 0>(bxr);
+              // edge bconds set only for the solvers that use them (remote ones post messages when constructed)
 
-              bc_set<bcyl, bcond::left, 1>(byl);
-              bc_set<bcyr, bcond::rght, 1>(byr);
+              // i1 is the index of the tile in y, needed by open bcond to zero perpendicular vectors only at domain edges
+              // NOTE: for remote bcond, thread_rank is 0 on purpose in 2D to have propre left/right message tags (no tiles with MPI)
+              if (i0 == 0)      bc_set<bcxl, bcond::left, 0>(bxl, i1, n1);
+              if (i0 == n0 - 1) bc_set<bcxr, bcond::rght, 0>(bxr, i1, n1);
 
-              shrdl.reset(new bcond::shared<real_t, solver_t::halo, solver_t::n_dims>()); // TODO: shrdy if n1 != 1
-              shrdr.reset(new bcond::shared<real_t, solver_t::halo, solver_t::n_dims>()); // TODO: shrdy if n1 != 1
+              // i0 is the index of the slab in x, giving distinct message tags to threads exchanging y edges with MPI
+              if (i1 == 0)      bc_set<bcyl, bcond::left, 1>(byl, i0, n0);
+              if (i1 == n1 - 1) bc_set<bcyr, bcond::rght, 1>(byr, i0, n0);
+
+              shrdxl.reset(new bcond::shared<real_t, solver_t::halo, solver_t::n_dims>());
+              shrdxr.reset(new bcond::shared<real_t, solver_t::halo, solver_t::n_dims>());
+              shrdyl.reset(new bcond::shared<real_t, solver_t::halo, solver_t::n_dims>());
+              shrdyr.reset(new bcond::shared<real_t, solver_t::halo, solver_t::n_dims>());
 
               algos.push_back(
                 new solver_t(
                   typename solver_t::ctor_args_t({
-                    i0,
+                    i0 * n1 + i1,
                     mem.get(),
-                    i0 == 0      ? bxl : shrdl,
-                    i0 == n0 - 1 ? bxr : shrdr,
-                    byl, byr,
+                    i0 == 0      ? bxl : shrdxl,
+                    i0 == n0 - 1 ? bxr : shrdxr,
+                    i1 == 0      ? byl : shrdyl,
+                    i1 == n1 - 1 ? byr : shrdyr,
                     mem->slab(grid_size[0], i0, n0),
                     mem->slab(grid_size[1], i1, n1)
                   }),
@@ -330,36 +444,43 @@ namespace libmpdataxx
           const std::array<rng_t, 3> &grid_size,
           const int &n1, const int &n0 = 1, const int &n2 = 1
         ) {
-          typename solver_t::bcp_t bxl, bxr, byl, byr, bzl, bzr, shrdl, shrdr;
+          typename solver_t::bcp_t bxl, bxr, byl, byr, bzl, bzr, shrdxl, shrdxr, shrdyl, shrdyr;
 
           // TODO: renew pointers only if invalid ?
-          for (int i0 = 0; i0 < n0; ++i0)
+          // algos pushed in the order of ranks (y slabs split into x tiles, see sharedmem::thread_part())
+          for (int i1 = 0; i1 < n1; ++i1)
           {
-            for (int i1 = 0; i1 < n1; ++i1)
+            for (int i0 = 0; i0 < n0; ++i0)
             {
               for (int i2 = 0; i2 < n2; ++i2)
               {
-                // i1 is the local thread rank, n1 is the number of threads. These are needed by remote bcond, because only rank=0 does mpi communication
-                bc_set<bcxl, bcond::left, 0>(bxl, i1, n1);
-                bc_set<bcxr, bcond::rght, 0>(bxr, i1, n1);
+                // edge bconds set only for the solvers that use them (remote ones post messages when constructed)
 
-                bc_set<bcyl, bcond::left, 1>(byl);
-                bc_set<bcyr, bcond::rght, 1>(byr);
+                // i1 is the local thread rank, giving distinct message tags to threads exchanging x edges with MPI
+                if (i0 == 0)      bc_set<bcxl, bcond::left, 0>(bxl, i1, n1);
+                if (i0 == n0 - 1) bc_set<bcxr, bcond::rght, 0>(bxr, i1, n1);
 
+                if (i1 == 0)      bc_set<bcyl, bcond::left, 1>(byl);
+                if (i1 == n1 - 1) bc_set<bcyr, bcond::rght, 1>(byr);
+
+                // z edges not split among threads, each solver has its own
                 bc_set<bczl, bcond::left, 2>(bzl);
                 bc_set<bczr, bcond::rght, 2>(bzr);
 
-                shrdl.reset(new bcond::shared<real_t, solver_t::halo, solver_t::n_dims>()); // TODO: shrdy if n1 != 1
-                shrdr.reset(new bcond::shared<real_t, solver_t::halo, solver_t::n_dims>()); // TODO: shrdy if n1 != 1
+                shrdxl.reset(new bcond::shared<real_t, solver_t::halo, solver_t::n_dims>());
+                shrdxr.reset(new bcond::shared<real_t, solver_t::halo, solver_t::n_dims>());
+                shrdyl.reset(new bcond::shared<real_t, solver_t::halo, solver_t::n_dims>());
+                shrdyr.reset(new bcond::shared<real_t, solver_t::halo, solver_t::n_dims>());
 
                 algos.push_back(
                   new solver_t(
                     typename solver_t::ctor_args_t({
-                      i1,
+                      i1 * n0 + i0,
                       mem.get(),
-                      bxl, bxr,
-                      i1 == 0      ? byl : shrdl,
-                      i1 == n1 - 1 ? byr : shrdr,
+                      i0 == 0      ? bxl : shrdxl,
+                      i0 == n0 - 1 ? bxr : shrdxr,
+                      i1 == 0      ? byl : shrdyl,
+                      i1 == n1 - 1 ? byr : shrdyr,
                       bzl, bzr,
                       mem->slab(grid_size[0], i0, n0),
                       mem->slab(grid_size[1], i1, n1),
@@ -375,12 +496,106 @@ namespace libmpdataxx
 
         virtual void solve(advance_arg_t nt) = 0;
 
+        // solve() measuring the per-thread compute time
+        void solve_timed(const advance_arg_t nt)
+        {
+          parallel([&](const int r)
+          {
+            double &wait = mem_t::barrier_wait();
+            wait = 0;
+            const auto t0 = std::chrono::steady_clock::now();
+            algos[r].solve(nt);
+            work[r] += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count() - wait;
+          });
+        }
+
+        // with constant dt, the run is split into windows of rebalance_window time steps
+        // (consecutive solve() calls continue the same time loop); with variable dt
+        // the window is counted in advance() calls
+        void advance_rebalanced(advance_arg_t nt)
+        {
+          if constexpr (!std::is_integral<advance_arg_t>::value)
+          {
+            solve_timed(nt);
+            if (++rebalance_steps >= rebalance_window) rebalance();
+          }
+          else
+          {
+            while (nt > 0)
+            {
+              const advance_arg_t n = std::min<advance_arg_t>(nt, rebalance_window - rebalance_steps);
+              solve_timed(n);
+              nt -= n;
+              rebalance_steps += n;
+              if (rebalance_steps >= rebalance_window) rebalance();
+            }
+          }
+        }
+
+        // shifts slab boundaries so that the measured compute time per gridpoint (assumed uniform
+        // within each slab) is split evenly; shared arrays are untouched, only the per-thread ijk change
+        void rebalance()
+        {
+          const int size = slabs.size(), d = mem->shmem_decomp_dim;
+          const int n = mem->grid_size[d].length(), first = mem->grid_size[d].first();
+          const double total = std::accumulate(work.begin(), work.end(), 0.);
+          const auto minmax = std::minmax_element(work.begin(), work.end());
+
+          // not worth it below 5% imbalance (timing noise)
+          if (total > 0 && *minmax.second - *minmax.first > .05 * total / size)
+          {
+            std::vector<double> cost;
+            for (int r = 0; r < size; ++r)
+              for (int c = slabs[r].first(); c <= slabs[r].last(); ++c)
+                cost.push_back(work[r] / slabs[r].length());
+
+            // slabs not narrower than the halo with neighbour-only synchronisation (see ctor)
+            const int min_width = mem->nbr_sync ? solver_t::halo : 1;
+
+            std::vector<int> lo(size + 1, 0);
+            lo[size] = n;
+            double acc = 0;
+            for (int r = 1, c = 0; r < size; ++r)
+            {
+              while (c < n && acc + cost[c] / 2 < total * r / size) acc += cost[c++];
+              // moving halfway to damp oscillations
+              lo[r] = std::max(lo[r-1] + min_width, std::min(n - (size - r) * min_width, (c + slabs[r].first() - first) / 2));
+            }
+
+            for (int r = 0; r < size; ++r)
+            {
+              slabs[r] = rng_t(first + lo[r], first + lo[r+1] - 1);
+              blitz::TinyVector<rng_t, solver_t::n_dims> ijk;
+              for (int dd = 0; dd < solver_t::n_dims; ++dd)
+                ijk[dd] = dd == d ? slabs[r] : mem->grid_size[dd];
+              algos[r].set_subdomain(idx_t<solver_t::n_dims>(ijk));
+            }
+          }
+
+          std::fill(work.begin(), work.end(), 0);
+          rebalance_steps = 0;
+        }
+
+        // runs job(rank) in each of the threads used by solve()
+        virtual void parallel(const std::function<void(int)> &job) = 0;
+
+        protected:
+
+        // to be called at the end of the ctors of derived classes (once their threads can be run);
+        // the pages touched in the thread that runs algos[i], i.e. the one computing on them
+        void numa_init(const typename solver_t::rt_params_t &p)
+        {
+          if (p.numa_alloc == numa_first_touch)
+            parallel([this](const int i) { mem->first_touch(algos[i].rank_()); });
+        }
+
         public:
 
         void advance(advance_arg_t nt) final
         {
           tmr.resume();
-          solve(nt);
+          if (rebalance_window == 0) solve(nt);
+          else advance_rebalanced(nt);
           tmr.stop();
         }
 
@@ -398,6 +613,33 @@ namespace libmpdataxx
 #endif
         }
 
+        const typename solver_t::arr_t advectee_global_gather(int e = 0, int root = 0) final
+        {
+          return mem->distmem.get_global_array(advectee(e), root);
+        }
+
+        const typename solver_t::arr_t advectee_global_slice(const idx_t<solver_t::n_dims> &box, int e = 0, int root = -1) final
+        {
+          for (int d = 0; d < solver_t::n_dims; ++d)
+            if (box.lbound(d) < 0 || box.ubound(d) >= mem->distmem.grid_size[d] || box.lbound(d) > box.ubound(d))
+              throw std::runtime_error("libmpdata++: advectee_global_slice() box outside of the domain");
+          return mem->distmem.get_global_array(advectee(e), box, root);
+        }
+
+        void advectee_global_chunks(const std::function<void(const typename solver_t::arr_t &)> &fun, int e = 0, int chunk = 1, int root = 0) final
+        {
+          if (chunk < 1) throw std::runtime_error("libmpdata++: advectee_global_chunks() chunk has to be positive");
+
+          blitz::TinyVector<rng_t, solver_t::n_dims> box;
+          for (int d = 0; d < solver_t::n_dims; ++d) box[d] = rng_t(0, mem->distmem.grid_size[d] - 1);
+          for (int i = 0; i < mem->distmem.grid_size[0]; i += chunk)
+          {
+            box[0] = rng_t(i, std::min(i + chunk, mem->distmem.grid_size[0]) - 1);
+            const auto arr = mem->distmem.get_global_array(advectee(e), idx_t<solver_t::n_dims>(box), root);
+            if (root < 0 || root == mem->distmem.rank()) fun(arr);
+          }
+        }
+
         void advectee_global_set(const typename solver_t::arr_t arr, int e = 0) final
         {
 #if defined(USE_MPI)
@@ -427,6 +669,96 @@ namespace libmpdataxx
           return mem->vab_relaxed_state(d);
         }
 
+        using init_fun_t = typename any<real_t, solver_t::n_dims, advance_arg_t>::init_fun_t;
+
+        void advectee_init(const init_fun_t &fun, int e = 0) final
+        {
+          parallel_assign(advectee(e), fun);
+        }
+
+        void advector_init(const init_fun_t &fun, int d = 0) final
+        {
+          parallel_assign(advector(d), fun);
+        }
+
+        void g_factor_init(const init_fun_t &fun) final
+        {
+          parallel_assign(g_factor(), fun);
+        }
+
+        void vab_coefficient_init(const init_fun_t &fun) final
+        {
+          parallel_assign(vab_coefficient(), fun);
+        }
+
+        void vab_relaxed_state_init(const init_fun_t &fun, int d = 0) final
+        {
+          parallel_assign(vab_relaxed_state(d), fun);
+        }
+
+        // the same with Blitz++ expressions (e.g. of index placeholders, giving global indices),
+        // evaluated by each thread over its whole part at once instead of calling a function per element
+        template <class expr_t>
+        void advectee_init(const blitz::ETBase<expr_t> &expr, int e = 0)
+        {
+          parallel_assign(advectee(e), expr);
+        }
+
+        template <class expr_t>
+        void advector_init(const blitz::ETBase<expr_t> &expr, int d = 0)
+        {
+          parallel_assign(advector(d), expr);
+        }
+
+        template <class expr_t>
+        void g_factor_init(const blitz::ETBase<expr_t> &expr)
+        {
+          parallel_assign(g_factor(), expr);
+        }
+
+        template <class expr_t>
+        void vab_coefficient_init(const blitz::ETBase<expr_t> &expr)
+        {
+          parallel_assign(vab_coefficient(), expr);
+        }
+
+        template <class expr_t>
+        void vab_relaxed_state_init(const blitz::ETBase<expr_t> &expr, int d = 0)
+        {
+          parallel_assign(vab_relaxed_state(d), expr);
+        }
+
+        // assigns a function of indices to arr (one of the arrays returned by the accessors above),
+        // each thread over the part of the subdomain of the solver it runs, in the storage order of arr
+        void parallel_assign(typename solver_t::arr_t arr, const init_fun_t &fun)
+        {
+          parallel([&](const int i) {
+            idx_t<solver_t::n_dims> idx;
+            if (!mem->thread_part(arr, algos[i].rank_(), idx)) return;
+
+            const auto ord = arr.ordering(); // ord(0): the dimension varying fastest in memory
+            blitz::TinyVector<int, solver_t::n_dims> ijk = idx.lbound();
+            for (int n = 0; n < solver_t::n_dims;)
+            {
+              arr(ijk) = fun(ijk);
+              for (n = 0; n < solver_t::n_dims && ++ijk[ord(n)] > idx.ubound(ord(n)); ++n)
+                ijk[ord(n)] = idx.lbound(ord(n));
+            }
+          });
+        }
+
+        // as above but with a Blitz++ expression, evaluated over the whole part at once
+        template <class expr_t>
+        void parallel_assign(typename solver_t::arr_t arr, const blitz::ETBase<expr_t> &expr)
+        {
+          parallel([&](const int i) {
+            idx_t<solver_t::n_dims> idx;
+            if (!mem->thread_part(arr, algos[i].rank_(), idx)) return;
+            expr_t ex(expr.unwrap()); // a copy per thread, expressions hold iterator state
+            arr(idx).reindex(idx.lbound()) = ex;
+          });
+        }
+
         typename solver_t::arr_t sclr_array(const std::string &name, int n = 0) final
         {
           return mem->sclr_array(name, n);
@@ -8,7 +8,16 @@
 #  include <cstdlib>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <deque>
 #include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace libmpdataxx
 {
@@ -38,6 +47,33 @@ public: // TODO: just a temp measure, make it private again
 
         private:
 
+#if defined(USE_MPI)
+        // processes sharing memory with this one (i.e. on the same node), their ranks in mpicom
+        // translated to ranks in node_comm (MPI_UNDEFINED for processes on other nodes)
+        MPI_Comm node_comm = MPI_COMM_NULL;
+        std::vector<int> node_ranks;
+
+        // window of memory shared within the node, see shm_alloc()
+        MPI_Win shm_win = MPI_WIN_NULL;
+
+        // windows shared within the node holding the arrays, see shm_alloc_arr()
+        std::vector<MPI_Win> shm_arr_wins;
+#endif
+        std::vector<std::pair<char*, std::size_t>> shm_arr_segs; // the parts belonging to this process
+#if defined(USE_MPI)
+
+#  if defined(LIBMPDATAXX_MPI_RMA)
+        // dynamic window exposing the shared arrays (see rma_attach()) and the counters of
+        // remote bconds (see rma_counters()) to one-sided transfers, with a passive-target
+        // epoch towards all processes open for its whole lifetime
+        MPI_Win rma_win = MPI_WIN_NULL;
+        std::deque<std::array<std::int64_t, 4>> rma_cnts; // deque: addresses stay valid
+#  endif
+
+        // tag of messages gathering global arrays (MPI_TAG_UB is at least that, above the tags of remote bconds)
+        static constexpr int global_tag = 32767;
+#endif
+
         template <typename Op, typename reduce_real_t> // some reductions done on different floating types (e.g. sum always on doubles)
         reduce_real_t reduce_hlpr(const reduce_real_t &val)
         {
@@ -51,10 +87,43 @@ public: // TODO: just a temp measure, make it private again
         }
 
 
+        template <typename Op>
+        void reduce_hlpr(double *vals, const int n)
+        {
+#if defined(USE_MPI)
+          std::vector<double> res(n);
+          boost::mpi::all_reduce(mpicom, vals, n, res.data(), Op());
+          std::copy(res.begin(), res.end(), vals);
+#endif
+        }
+
         public:
 
         std::array<int, n_dims> grid_size;
 
+        // Cartesian arrangement of processes: number of processes and coordinates of this process
+        // in each dimension, and ranks of the left and right neighbours (wrapping around)
+        std::array<int, n_dims> cart_dims, cart_coords;
+        std::array<std::array<int, 2>, n_dims> peers;
+
+        // range of gridpoints in dimension d of the processes with Cartesian coordinate c
+        rng_t cart_slab(const int d, const int c) const
+        {
+          return domain_decomposition::slab(rng_t(0, grid_size[d]-1), c, cart_dims[d]);
+        }
+
+        // rank (in mpicom) of the process with the given Cartesian coordinates
+        int cart_rank(const std::array<int, n_dims> &coords)
+        {
+#if defined(USE_MPI)
+          int r;
+          MPI_Cart_rank(mpicom, coords.data(), &r);
+          return r;
+#else
+          return 0;
+#endif
+        }
+
         int rank()
         {
 #if defined(USE_MPI)
@@ -107,62 +176,217 @@ public: // TODO: just a temp measure, make it private again
           return reduce_hlpr<std::plus<double>>(val);
         }
 
-        template<class arr_t>
-        const arr_t get_global_array(arr_t arr, const bool kij_to_kji)
+        // in-place reductions of n values with a single all-reduce call
+        void sum(double *vals, const int n)
+        {
+          reduce_hlpr<std::plus<double>>(vals, n);
+        }
+
+        void max(double *vals, const int n)
         {
 #if defined(USE_MPI)
-          // a vector of number of elements to be sent by each non-root process
-          std::vector<int> sizes(size());
-          std::iota(sizes.begin(), sizes.end(), 0); // fill with 0,1,2,3,...
+          reduce_hlpr<boost::mpi::maximum<double>>(vals, n);
+#endif
+        }
 
-          for(auto &_size : sizes) 
-          { 
-            _size = domain_decomposition::slab(rng_t(0, grid_size[0]-1), _size, size()).length();
-            for(int i=1; i<n_dims; ++i)
-              _size *= grid_size[i];
-          }
+        // true if the process of rank r (in mpicom) shares memory with this one
+        bool node_local(const int r) const
+        {
+#if defined(USE_MPI)
+          return node_ranks.at(r) != MPI_UNDEFINED;
+#else
+          return false;
+#endif
+        }
 
-          // calc displacement
-          std::vector<int> displ(sizes.size());
-          std::partial_sum(sizes.begin(), sizes.end(), displ.begin());
-          std::transform(displ.begin(), displ.end(), sizes.begin(), displ.begin(), std::minus<int>()); // exclusive_scan is c++17
-          // a vector that will store the received data, relevant only on process rank=0
-          std::vector<real_t> out_values(std::accumulate(grid_size.begin(), grid_size.end(), 1, std::multiplies<int>()));
+        // allocates a window of memory shared by the processes on the node, with the given number
+        // of (zeroed) bytes belonging to this process; collective over all processes of the node
+        void shm_alloc(const std::size_t bytes)
+        {
+#if defined(USE_MPI)
+          assert(shm_win == MPI_WIN_NULL);
+          // allowing each process' part to be placed in its NUMA node
+          MPI_Info info;
+          MPI_Info_create(&info);
+          MPI_Info_set(info, "alloc_shared_noncontig", "true");
+          void *base;
+          MPI_Win_allocate_shared(bytes, 1, info, node_comm, &base, &shm_win);
+          MPI_Info_free(&info);
+          std::memset(base, 0, bytes);
+          MPI_Barrier(node_comm);
+#endif
+        }
+
+        // the part of the shared window (see shm_alloc()) belonging to the process of rank r (in mpicom)
+        char *shm_base(const int r) const
+        {
+#if defined(USE_MPI)
+          assert(node_local(r) && shm_win != MPI_WIN_NULL);
+          MPI_Aint bytes;
+          int disp_unit;
+          void *base;
+          MPI_Win_shared_query(shm_win, node_ranks.at(r), &bytes, &disp_unit, &base);
+          return static_cast<char*>(base);
+#else
+          return nullptr;
+#endif
+        }
+
+        // allocates memory for an array in a new window shared by the processes on the node, not touching it
+        // (so that the pages land where the array is first written to); collective over all processes of the node,
+        // which hence allocate their arrays in the same order, the windows being identified by that order
+        void *shm_alloc_arr(const std::size_t bytes)
+        {
+#if defined(USE_MPI)
+          MPI_Info info;
+          MPI_Info_create(&info);
+          MPI_Info_set(info, "alloc_shared_noncontig", "true");
+          void *base;
+          shm_arr_wins.push_back(MPI_WIN_NULL);
+          MPI_Win_allocate_shared((bytes + 63) / 64 * 64, 1, info, node_comm, &base, &shm_arr_wins.back());
+          MPI_Info_free(&info);
+          shm_arr_segs.emplace_back(static_cast<char*>(base), bytes);
+          return base;
+#else
+          assert(false);
+          return nullptr;
+#endif
+        }
 
-          std::vector<real_t> in_values_vec;
+        // the parts of the arrays allocated with shm_alloc_arr() belonging to this process
+        const std::vector<std::pair<char*, std::size_t>> &shm_arrs() const
+        {
+          return shm_arr_segs;
+        }
 
-          if(kij_to_kji)
+        // the same for the process of rank r (in mpicom), the addresses as seen by this process
+        std::vector<char*> shm_arrs(const int r) const
+        {
+          std::vector<char*> ret;
+#if defined(USE_MPI)
+          assert(node_local(r));
+          for (const auto &win : shm_arr_wins)
           {
-            // create an array that will store advectee to be sent in a contiguous memory block using the (default) kji storage order
-            // NOTE: libmpdata++ 3d blitz arrays, like advectee, are in the kij order
-            arr_t in_values_arr(arr.shape());
-            in_values_arr = arr;
-            // wrap in_values_arr in a std::vector
-            in_values_vec = std::vector<real_t>(in_values_arr.begin(), in_values_arr.end());
+            MPI_Aint bytes;
+            int disp_unit;
+            void *base;
+            MPI_Win_shared_query(win, node_ranks.at(r), &bytes, &disp_unit, &base);
+            ret.push_back(static_cast<char*>(base));
           }
-          else
+#endif
+          return ret;
+        }
+
+#if defined(USE_MPI) && defined(LIBMPDATAXX_MPI_RMA)
+        // exposes the given memory to one-sided transfers (until the window is freed by the dtor)
+        void rma_attach(void *base, const std::size_t bytes)
+        {
+          if (bytes > 0) MPI_Win_attach(rma_win, base, bytes);
+        }
+
+        MPI_Win rma_window() const
+        {
+          return rma_win;
+        }
+
+        // zeroed counters exposed to one-sided transfers, valid as long as the window
+        std::int64_t *rma_counters()
+        {
+          rma_cnts.emplace_back();
+          rma_cnts.back().fill(0);
+          rma_attach(rma_cnts.back().data(), sizeof(rma_cnts.back()));
+          return rma_cnts.back().data();
+        }
+#endif
+
+        // gathers the part within box (in global indices) of a distributed array given by its local
+        // parts arr (indexed globally, like advectee()) on the process of rank root only, or on all
+        // processes if root < 0 (at the cost of broadcasting the box); the result is indexed globally,
+        // stored in the default (C) order, and empty on processes other than root
+        template<class arr_t>
+        blitz::Array<real_t, n_dims> get_global_array(const arr_t &arr, const idx_t<n_dims> &box, const int root = -1)
+        {
+#if defined(USE_MPI)
+          const int root_rank = std::max(root, 0);
+          const bool gather = rank() == root_rank; // receives the parts of the other processes
+          const bool recv = root < 0 || gather;    // gets the result (broadcast from root_rank if root < 0)
+
+          blitz::Array<real_t, n_dims> res;
+          if (recv)
           {
-            // create an array that will store arr to be sent in a contiguous memory block
-            in_values_vec = std::vector<real_t>(arr.size());
-            std::copy(arr.begin(), arr.end(), in_values_vec.begin());
+            res.resize(blitz::TinyVector<int, n_dims>(box.ubound() - box.lbound() + 1));
+            res.reindexSelf(box.lbound());
           }
 
-          // gather the data from all processes on rank=0
-          boost::mpi::gatherv(mpicom, in_values_vec, out_values.data(), sizes, displ, 0);
-          // send the result to other processes
-          boost::mpi::broadcast(mpicom, out_values, 0);
+          for (int r = 0; r < size(); ++r)
+          {
+            if (!gather && r != rank()) continue;
+
+            // the part of the box in the block of process r
+            int coords[n_dims], shape[n_dims], subshape[n_dims], starts[n_dims];
+            MPI_Cart_coords(mpicom, r, n_dims, coords);
+            blitz::TinyVector<rng_t, n_dims> part;
+            bool empty = false;
+            for (int d = 0; d < n_dims; ++d)
+            {
+              const rng_t slab = cart_slab(d, coords[d]);
+              part[d] = rng_t(std::max(slab.first(), box.lbound(d)), std::min(slab.last(), box.ubound(d)));
+              empty = empty || part[d].first() > part[d].last();
+              shape[d] = box.ubound(d) - box.lbound(d) + 1;
+              subshape[d] = part[d].length();
+              starts[d] = part[d].first() - box.lbound(d);
+            }
+            if (empty) continue;
+
+            if (r == rank())
+            {
+              if (gather)
+                res(idx_t<n_dims>(part)) = arr(idx_t<n_dims>(part));
+              else
+              {
+                // contiguous copy in the default order (3D arrays of libmpdata++ are stored in the kij order)
+                blitz::Array<real_t, n_dims> send(arr(idx_t<n_dims>(part)).shape());
+                send = arr(idx_t<n_dims>(part));
+                MPI_Send(send.data(), send.numElements(), boost::mpi::get_mpi_datatype(real_t()), root_rank, global_tag, mpicom);
+              }
+            }
+            else
+            {
+              // received directly into its place in the result
+              MPI_Datatype type;
+              MPI_Type_create_subarray(n_dims, shape, subshape, starts, MPI_ORDER_C, boost::mpi::get_mpi_datatype(real_t()), &type);
+              MPI_Type_commit(&type);
+              MPI_Recv(res.data(), 1, type, r, global_tag, mpicom, MPI_STATUS_IGNORE);
+              MPI_Type_free(&type);
+            }
+          }
 
-          blitz::Array<real_t, n_dims> res(out_values.data(), get_shape(grid_size), blitz::duplicateData);
+          if (root < 0) MPI_Bcast(res.data(), res.numElements(), boost::mpi::get_mpi_datatype(real_t()), root_rank, mpicom);
           return res;
 #else
-          return arr;
+          return arr(box).reindex(box.lbound());
 #endif
         }
 
+        // the whole domain
+        template<class arr_t>
+        blitz::Array<real_t, n_dims> get_global_array(const arr_t &arr, const int root = -1)
+        {
+          blitz::TinyVector<rng_t, n_dims> box;
+          for (int d = 0; d < n_dims; ++d) box[d] = rng_t(0, grid_size[d] - 1);
+          return get_global_array(arr, idx_t<n_dims>(box), root);
+        }
+
         // ctor
-        distmem(const std::array<int, n_dims> &grid_size)
-          : grid_size(grid_size)
+        distmem(
+          const std::array<int, n_dims> &grid_size,
+          const int decomp_dims = 1 // number of leading dimensions in which processes are arranged
+        ) : grid_size(grid_size)
         {
+          cart_dims.fill(1);
+          cart_coords.fill(0);
+          peers.fill({0, 0});
+
 #if !defined(USE_MPI)
           if (
             // mvapich2
@@ -190,7 +414,72 @@ public: // TODO: just a temp measure, make it private again
           {
             throw std::runtime_error("libmpdata++: failed to initialise MPI environment with MPI_THREAD_MULTIPLE");
           }
-          mpicom = boost::mpi::communicator(MPI_COMM_WORLD, boost::mpi::comm_duplicate); // use a duplicate of MPI_COMM_WORLD, can't construct it before MPI_Init call (?)
+
+          // at most x and y (in 3D the vertical is not split, as the open bconds assume whole columns)
+          if (decomp_dims < 1 || decomp_dims > std::min(n_dims, 2))
+            throw std::runtime_error("libmpdata++: mpi_decomp_dims has to be 1 or 2 (and not greater than the number of dimensions)");
+
+          // Cartesian communicator, periodic in all dimensions (non-cyclic edges are not remote anyhow),
+          // without reordering so that ranks are the same as in MPI_COMM_WORLD (used by remote bconds);
+          // can't construct it before MPI_Init call
+          int dims[n_dims], periods[n_dims], coords[n_dims], world_size;
+          for (int d = 0; d < n_dims; ++d)
+          {
+            dims[d] = d < decomp_dims ? 0 : 1;
+            periods[d] = 1;
+          }
+          MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+          MPI_Dims_create(world_size, n_dims, dims);
+          MPI_Comm cart;
+          MPI_Cart_create(MPI_COMM_WORLD, n_dims, dims, periods, 0, &cart);
+          mpicom = boost::mpi::communicator(cart, boost::mpi::comm_take_ownership);
+
+          MPI_Cart_coords(cart, mpicom.rank(), n_dims, coords);
+          for (int d = 0; d < n_dims; ++d)
+          {
+            cart_dims[d] = dims[d];
+            cart_coords[d] = coords[d];
+            MPI_Cart_shift(cart, d, 1, &peers[d][0], &peers[d][1]);
+            if (grid_size[d] < cart_dims[d])
+              throw std::runtime_error("libmpdata++: more MPI processes than gridpoints in dimension " + std::to_string(d));
+          }
+
+          // processes on the same node
+          MPI_Comm_split_type(cart, MPI_COMM_TYPE_SHARED, mpicom.rank(), MPI_INFO_NULL, &node_comm);
+          MPI_Group cart_group, node_group;
+          MPI_Comm_group(cart, &cart_group);
+          MPI_Comm_group(node_comm, &node_group);
+          std::vector<int> ranks(world_size);
+          std::iota(ranks.begin(), ranks.end(), 0);
+          node_ranks.resize(world_size);
+          MPI_Group_translate_ranks(cart_group, world_size, ranks.data(), node_group, node_ranks.data());
+          MPI_Group_free(&cart_group);
+          MPI_Group_free(&node_group);
+
+#  if defined(LIBMPDATAXX_MPI_RMA)
+          MPI_Win_create_dynamic(MPI_INFO_NULL, cart, &rma_win);
+          MPI_Win_lock_all(MPI_MODE_NOCHECK, rma_win);
+#  endif
+#endif
+        }
+
+        // dtor
+        ~distmem()
+        {
+#if defined(USE_MPI)
+          int finalized;
+          MPI_Finalized(&finalized);
+          if (finalized) return;
+          if (shm_win != MPI_WIN_NULL) MPI_Win_free(&shm_win);
+          for (auto &win : shm_arr_wins) MPI_Win_free(&win);
+#  if defined(LIBMPDATAXX_MPI_RMA)
+          if (rma_win != MPI_WIN_NULL)
+          {
+            MPI_Win_unlock_all(rma_win);
+            MPI_Win_free(&rma_win);
+          }
+#  endif
+          if (node_comm != MPI_COMM_NULL) MPI_Comm_free(&node_comm);
 #endif
         }
       };
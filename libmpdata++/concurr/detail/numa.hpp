@@ -0,0 +1,53 @@
+/** @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(__linux__)
+#  include <unistd.h>
+#  include <sys/syscall.h>
+#  include <linux/mempolicy.h>
+#endif
+
+namespace libmpdataxx
+{
+  namespace concurr
+  {
+    // placement of the memory pages of shared arrays on NUMA nodes
+    enum numa_alloc_t
+    {
+      numa_default,     // pages land on the node of the thread that first writes to them (typically the master thread)
+      numa_first_touch, // each thread first writes to its own subdomain (including outer halos) before the first advance()
+      numa_interleave   // pages are interleaved round-robin across all NUMA nodes (Linux only)
+    };
+
+    namespace detail
+    {
+      // sets interleaved memory policy for pages not yet touched in [ptr, ptr + bytes)
+      // the mbind syscall is used directly to avoid depending on libnuma;
+      // failures (e.g. kernels without NUMA support) are ignored as the policy is only a hint
+      inline void numa_set_interleave(void *ptr, const std::size_t bytes)
+      {
+#if defined(__linux__) && defined(SYS_mbind)
+        const std::uintptr_t page = sysconf(_SC_PAGESIZE);
+        const std::uintptr_t
+          beg = reinterpret_cast<std::uintptr_t>(ptr) & ~(page - 1),
+          end = reinterpret_cast<std::uintptr_t>(ptr) + bytes;
+
+        // all nodes, the kernel restricts the mask to the nodes allowed for the process
+        const unsigned long nodemask = ~0UL;
+        syscall(SYS_mbind, beg, end - beg, MPOL_INTERLEAVE, &nodemask, 8 * sizeof(nodemask), 0);
+#else
+        throw std::runtime_error("libmpdata++: interleaved NUMA allocation is supported on Linux only");
+#endif
+      }
+    } // namespace detail
+  } // namespace concurr
+} // namespace libmpdataxx
@@ -13,8 +13,15 @@
 #include <libmpdata++/formulae/arakawa_c.hpp>
 #include <libmpdata++/formulae/domain_decomposition.hpp>
 #include <libmpdata++/concurr/detail/distmem.hpp>
+#include <libmpdata++/concurr/detail/numa.hpp>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
 
 namespace libmpdataxx
 {
@@ -34,7 +41,14 @@ namespace libmpdataxx
         static_assert(n_tlev > 0, "n_tlev <= 0");
 
         std::unique_ptr<blitz::Array<real_t, 1>> xtmtmp;
-        std::unique_ptr<blitz::Array<double, 1>> sumtmp;
+        std::unique_ptr<blitz::Array<double, 2>> sumtmp; // (slice in shmem_decomp_dim, tile in shmem_tile_dim)
+        std::unique_ptr<blitz::Array<double, 3>> redtmp; // (entry of a reduction batch, slice in shmem_decomp_dim, tile in shmem_tile_dim)
+        std::unique_ptr<blitz::Array<double, 2>> redxtm; // (entry of a reduction batch, rank)
+        std::unique_ptr<blitz::Array<double, 1>> redres; // (entry of a reduction batch)
+
+        // per-subdomain counters of passed barrier_nbr() calls, each on a separate cache line
+        struct alignas(64) epoch_t { std::atomic<unsigned long long> val{0}; };
+        std::unique_ptr<epoch_t[]> epochs;
 
         protected:
 
@@ -47,12 +61,73 @@ namespace libmpdataxx
         const int size;
         std::array<rng_t, n_dims> grid_size;
         bool panic = false; // for multi-threaded SIGTERM handling
+        bool nbr_sync = false; // if true, halo exchanges synchronise only neighbouring subdomains (set by concurr)
+        bool xchng_overlap = false; // if true, advop() exchanges advectee halos overlapping it with computations (set by concurr)
+        numa_alloc_t numa_alloc = numa_default; // placement of array memory on NUMA nodes (set by concurr before alloc)
+        bool shm_arrays = false; // if true, arrays are placed in memory shared with the processes on the node (set by concurr before alloc)
+        int n_scratch = 1; // number of sets of solver scratch arrays in tmp (set by concurr before alloc)
+        bool time_barriers = false; // if true, barrier_wait() accumulates time spent in barriers (set by concurr)
+
+        // wall time (in seconds) the calling thread spent waiting in barriers
+        static double &barrier_wait()
+        {
+          static thread_local double t = 0;
+          return t;
+        }
+
+        // numbers of barrier() and barrier_nbr() calls made by the calling thread
+        static unsigned long long &barrier_calls()
+        {
+          static thread_local unsigned long long n = 0;
+          return n;
+        }
+
+        static unsigned long long &barrier_nbr_calls()
+        {
+          static thread_local unsigned long long n = 0;
+          return n;
+        }
+
+        // adds the lifetime of the object to barrier_wait() and counts the call,
+        // to be used in barrier implementations
+        class wait_timer
+        {
+          const bool on;
+          std::chrono::steady_clock::time_point t0;
+
+          public:
+
+          wait_timer(const bool on, unsigned long long &calls = barrier_calls()) : on(on)
+          {
+            ++calls;
+            if (on) t0 = std::chrono::steady_clock::now();
+          }
+
+          ~wait_timer()
+          {
+            if (on) barrier_wait() += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+          }
+        };
 
         // dimension in which sharedmem domain decomposition is done
         // 1D and 2D - domain decomposed in 0-th dimension (x)
         // 3D - domain decomposed in 1-st dimension (y) for better workload balance in MPI runs (MPI is decomposed in x)
         const int shmem_decomp_dim;
 
+        // dimension in which the domain is additionally split into tiles if there are more subdomains
+        // than gridpoints in shmem_decomp_dim (2D - y, 3D - x, not applicable in 1D)
+        const int shmem_tile_dim;
+
+        // number of subdomains along shmem_decomp_dim and along shmem_tile_dim;
+        // subdomain (thread) rank r corresponds to tile (r / tiles[1], r % tiles[1])
+        std::array<int, 2> tiles;
+
+        // maximal number of subdomains for a given grid
+        static int max_size(const std::array<int, n_dims> &grid_size)
+        {
+          return n_dims == 1 ? grid_size[0] : grid_size[0] * grid_size[1];
+        }
+
         detail::distmem<real_t, n_dims> distmem;
 
         // TODO: these are public because used from outside in alloc - could friendship help?
@@ -79,6 +154,26 @@ namespace libmpdataxx
           assert(false && "sharedmem_common::barrier() called!");
         }
 
+        // waits only for the two neighbouring subdomains (in shmem_decomp_dim, wrapping around)
+        // to reach the same point; enough around halo exchanges in which a subdomain reads
+        // nothing but its own data and the neighbours' data
+        void barrier_nbr(const int &rank)
+        {
+          if (size == 1) return;
+          const wait_timer wt(time_barriers, barrier_nbr_calls());
+          const auto epoch = epochs[rank].val.fetch_add(1, std::memory_order_acq_rel) + 1;
+          for (const int nbr : {(rank + size - 1) % size, (rank + 1) % size})
+            while (epochs[nbr].val.load(std::memory_order_acquire) < epoch)
+              std::this_thread::yield();
+        }
+
+        // barrier to be used around halo exchanges
+        void barrier_xchng(const int &rank)
+        {
+          if (nbr_sync) barrier_nbr(rank);
+          else barrier();
+        }
+
         void cycle(const int &rank)
         {
           barrier();
@@ -88,34 +183,51 @@ namespace libmpdataxx
 
         // ctors
         // TODO: fill reducetmp with NaNs (or use 1-element arrvec_t - it's NaN-filled by default)
-        sharedmem_common(const std::array<int, n_dims> &grid_size, const int &size)
-          : n(0), distmem(grid_size), size(size), shmem_decomp_dim(n_dims < 3 ? 0 : 1) // TODO: is n(0) needed?
+        sharedmem_common(const std::array<int, n_dims> &grid_size, const int &size, const int &mpi_decomp_dims = 1)
+          : n(0), distmem(grid_size, mpi_decomp_dims), size(size), shmem_decomp_dim(n_dims < 3 ? 0 : 1), shmem_tile_dim(n_dims == 1 ? -1 : n_dims == 2 ? 1 : 0) // TODO: is n(0) needed?
         {
+          // block of the Cartesian MPI decomposition (x slabs unless mpi_decomp_dims > 1)
           for (int d = 0; d < n_dims; ++d)
           {
-            this->grid_size[d] = slab(
-              rng_t(0, grid_size[d]-1),
-              d == 0 ? distmem.rank() : 0,          // decomposition along x, because that's MPI decomposition
-              d == 0 ? distmem.size() : 1
-             // d == shmem_decomp_dim ? distmem.rank() : 0,
-             // d == shmem_decomp_dim ? distmem.size() : 1
-            );
+            this->grid_size[d] = distmem.cart_slab(d, distmem.cart_coords[d]);
             origin[d] = this->grid_size[d].first();
           }
 
-          if (size > grid_size[0])
-            throw std::runtime_error("libmpdata++: number of subdomains greater than number of gridpoints");
+          // slabs if possible, 2D tiles with as many subdomains along shmem_decomp_dim as possible otherwise
+          // (not with MPI, as remote bconds assume a single subdomain along the MPI-decomposed edges)
+          tiles = {size, 1};
+          if (size > this->grid_size[shmem_decomp_dim].length())
+          {
+            tiles = {0, 0};
+            if (n_dims > 1 && distmem.size() == 1)
+            {
+              for (int n0 = this->grid_size[shmem_decomp_dim].length(); n0 > 0; --n0)
+              {
+                if (size % n0 == 0 && size / n0 <= this->grid_size[shmem_tile_dim].length())
+                {
+                  tiles = {n0, size / n0};
+                  break;
+                }
+              }
+            }
+            if (tiles[0] == 0)
+              throw std::runtime_error("libmpdata++: number of subdomains greater than number of gridpoints");
+          }
 
           if (n_dims != 1)
-            sumtmp.reset(new blitz::Array<double, 1>(this->grid_size[shmem_decomp_dim])); 
+            sumtmp.reset(new blitz::Array<double, 2>(this->grid_size[shmem_decomp_dim], rng_t(0, tiles[1] - 1)));
           xtmtmp.reset(new blitz::Array<real_t, 1>(size));
+          redtmp.reset(new blitz::Array<double, 3>(rng_t(0, max_batch - 1), this->grid_size[shmem_decomp_dim], rng_t(0, tiles[1] - 1)));
+          redxtm.reset(new blitz::Array<double, 2>(rng_t(0, max_batch - 1), rng_t(0, size - 1)));
+          redres.reset(new blitz::Array<double, 1>(rng_t(0, max_batch - 1)));
+          epochs.reset(new epoch_t[size]);
         }
 
         /// @brief concurrency-aware summation of array elements
         double sum(const int &rank, const arr_t &arr, const idx_t<n_dims> &ijk, const bool sum_khn)
         {
           // doing a two-step sum to reduce numerical error
-          // and make parallel results reproducible
+          // and make parallel results reproducible (for a given number of tiles in shmem_tile_dim)
           for (int c = ijk[shmem_decomp_dim].first(); c <= ijk[shmem_decomp_dim].last(); ++c) // TODO: optimise for i.count() == 1
           {
             auto slice_idx = ijk;
@@ -123,9 +235,9 @@ namespace libmpdataxx
             slice_idx.ubound(shmem_decomp_dim) = c;
 
             if (sum_khn)
-              (*sumtmp)(c) = blitz::kahan_sum(arr(slice_idx));
+              (*sumtmp)(c, rank % tiles[1]) = blitz::kahan_sum(arr(slice_idx));
             else
-              (*sumtmp)(c) = blitz::sum(arr(slice_idx));
+              (*sumtmp)(c, rank % tiles[1]) = blitz::sum(arr(slice_idx));
           }
           barrier(); // wait for all threads to calc their part
 #if !defined(USE_MPI)
@@ -141,14 +253,14 @@ namespace libmpdataxx
           {
             // master thread calculates the sum from this process, stores in shared array
             if (sum_khn)
-              (*sumtmp)(grid_size[shmem_decomp_dim].first())= blitz::kahan_sum(*sumtmp); // inplace?!
+              (*sumtmp)(grid_size[shmem_decomp_dim].first(), 0)= blitz::kahan_sum(*sumtmp); // inplace?!
             else
-              (*sumtmp)(grid_size[shmem_decomp_dim].first())= blitz::sum(*sumtmp); // inplace?!
+              (*sumtmp)(grid_size[shmem_decomp_dim].first(), 0)= blitz::sum(*sumtmp); // inplace?!
             // master thread calculates sum of sums from all processes
-            (*sumtmp)(grid_size[shmem_decomp_dim].first()) = this->distmem.sum((*sumtmp)(grid_size[shmem_decomp_dim].first())); // inplace?!
+            (*sumtmp)(grid_size[shmem_decomp_dim].first(), 0) = this->distmem.sum((*sumtmp)(grid_size[shmem_decomp_dim].first(), 0)); // inplace?!
           }
           barrier();
-          double res = (*sumtmp)(grid_size[shmem_decomp_dim].first()); // propagate the total sum to all threads of the process
+          double res = (*sumtmp)(grid_size[shmem_decomp_dim].first(), 0); // propagate the total sum to all threads of the process
           barrier(); // to avoid sumtmp being overwritten by next call to sum from other thread
           return res;
 #endif
@@ -166,9 +278,9 @@ namespace libmpdataxx
             slice_idx.ubound(shmem_decomp_dim) = c;
 
             if (sum_khn)
-              (*sumtmp)(c) = blitz::kahan_sum(arr1(slice_idx) * arr2(slice_idx));
+              (*sumtmp)(c, rank % tiles[1]) = blitz::kahan_sum(arr1(slice_idx) * arr2(slice_idx));
             else
-              (*sumtmp)(c) = blitz::sum(arr1(slice_idx) * arr2(slice_idx));
+              (*sumtmp)(c, rank % tiles[1]) = blitz::sum(arr1(slice_idx) * arr2(slice_idx));
           }
           // TODO: code below same as in the function above
           barrier(); // wait for all threads to calc their part
@@ -185,14 +297,14 @@ namespace libmpdataxx
           {
             // master thread calculates the sum from this process, stores in shared array
             if (sum_khn)
-              (*sumtmp)(grid_size[shmem_decomp_dim].first())= blitz::kahan_sum(*sumtmp); // inplace?!
+              (*sumtmp)(grid_size[shmem_decomp_dim].first(), 0)= blitz::kahan_sum(*sumtmp); // inplace?!
             else
-              (*sumtmp)(grid_size[shmem_decomp_dim].first())= blitz::sum(*sumtmp); // inplace?!
+              (*sumtmp)(grid_size[shmem_decomp_dim].first(), 0)= blitz::sum(*sumtmp); // inplace?!
             // master thread calculates sum of sums from all processes
-            (*sumtmp)(grid_size[shmem_decomp_dim].first()) = this->distmem.sum((*sumtmp)(grid_size[shmem_decomp_dim].first())); // inplace?!
+            (*sumtmp)(grid_size[shmem_decomp_dim].first(), 0) = this->distmem.sum((*sumtmp)(grid_size[shmem_decomp_dim].first(), 0)); // inplace?!
           }
           barrier();
-          double res = (*sumtmp)(grid_size[shmem_decomp_dim].first()); // propagate the total sum to all threads of the process
+          double res = (*sumtmp)(grid_size[shmem_decomp_dim].first(), 0); // propagate the total sum to all threads of the process
           barrier(); // to avoid sumtmp being overwritten by next call to sum from other thread
           return res;
 #endif
@@ -245,6 +357,102 @@ namespace libmpdataxx
 #endif
         }
 
+        // batched reductions: each entry is a sum of array elements, a sum of an (element-wise)
+        // product of two arrays, or a min/max of array elements, all over the same subdomain;
+        // a batch costs the synchronisation of a single sum(), min() or max() call
+        // (and one MPI all-reduce for the sums plus one for the min/max values),
+        // results are the same as from separate calls
+        enum reduction_op_t { reduce_sum, reduce_min, reduce_max };
+
+        struct reduction_t
+        {
+          reduction_op_t op;
+          const arr_t *arr1, *arr2; // arr2 used for sums of products only
+        };
+
+        static reduction_t sum_of(const arr_t &arr) { return {reduce_sum, &arr, nullptr}; }
+        static reduction_t sum_of(const arr_t &arr1, const arr_t &arr2) { return {reduce_sum, &arr1, &arr2}; }
+        static reduction_t min_of(const arr_t &arr) { return {reduce_min, &arr, nullptr}; }
+        static reduction_t max_of(const arr_t &arr) { return {reduce_max, &arr, nullptr}; }
+
+        static constexpr int max_batch = 8; // longer batches are done in chunks
+
+        std::vector<double> reduce(const int &rank, const std::vector<reduction_t> &batch, const idx_t<n_dims> &ijk, const bool sum_khn)
+        {
+          std::vector<double> res(batch.size());
+
+          for (std::size_t b0 = 0; b0 < batch.size(); b0 += max_batch)
+          {
+            const int nb = std::min<std::size_t>(max_batch, batch.size() - b0);
+
+            // partial results of this thread (sums done per slice as in sum())
+            for (int b = 0; b < nb; ++b)
+            {
+              const reduction_t &red = batch[b0 + b];
+              if (red.op != reduce_sum)
+              {
+                (*redxtm)(b, rank) = red.op == reduce_min ? blitz::min((*red.arr1)(ijk)) : blitz::max((*red.arr1)(ijk));
+                continue;
+              }
+              for (int c = ijk[shmem_decomp_dim].first(); c <= ijk[shmem_decomp_dim].last(); ++c)
+              {
+                auto slice_idx = ijk;
+                slice_idx.lbound(shmem_decomp_dim) = c;
+                slice_idx.ubound(shmem_decomp_dim) = c;
+
+                double &part = (*redtmp)(b, c, rank % tiles[1]);
+                if (red.arr2 == nullptr)
+                  part = sum_khn ? blitz::kahan_sum((*red.arr1)(slice_idx)) : blitz::sum((*red.arr1)(slice_idx));
+                else
+                  part = sum_khn
+                    ? blitz::kahan_sum((*red.arr1)(slice_idx) * (*red.arr2)(slice_idx))
+                    : blitz::sum((*red.arr1)(slice_idx) * (*red.arr2)(slice_idx));
+              }
+            }
+            barrier(); // wait for all threads to calc their part
+
+            auto combine = [&](const int b) -> double
+            {
+              const auto all = rng_t::all();
+              switch (batch[b0 + b].op)
+              {
+                case reduce_min: return blitz::min((*redxtm)(b, all));
+                case reduce_max: return blitz::max((*redxtm)(b, all));
+                default: return sum_khn ? blitz::kahan_sum((*redtmp)(b, all, all)) : blitz::sum((*redtmp)(b, all, all));
+              }
+            };
+#if !defined(USE_MPI)
+            for (int b = 0; b < nb; ++b)
+              res[b0 + b] = combine(b);
+            barrier();
+#else
+            if (rank == 0)
+            {
+              // master thread reduces across processes, sums and min/max values separately (min as max of negated values)
+              std::vector<double> sums, xtms;
+              for (int b = 0; b < nb; ++b)
+              {
+                const double val = combine(b);
+                if (batch[b0 + b].op == reduce_sum) sums.push_back(val);
+                else xtms.push_back(batch[b0 + b].op == reduce_min ? -val : val);
+              }
+              if (!sums.empty()) this->distmem.sum(sums.data(), sums.size());
+              if (!xtms.empty()) this->distmem.max(xtms.data(), xtms.size());
+              for (int b = nb - 1; b >= 0; --b)
+              {
+                if (batch[b0 + b].op == reduce_sum) { (*redres)(b) = sums.back(); sums.pop_back(); }
+                else { (*redres)(b) = batch[b0 + b].op == reduce_min ? -xtms.back() : xtms.back(); xtms.pop_back(); }
+              }
+            }
+            barrier();
+            for (int b = 0; b < nb; ++b)
+              res[b0 + b] = (*redres)(b); // propagate the results to all threads of the process
+            barrier(); // to avoid redres being overwritten by the next call from other thread
+#endif
+          }
+          return res;
+        }
+
         // single-threaded, MPI-aware versions of the min and max functions
         real_t min(const arr_t &arr)
         {
@@ -279,11 +487,68 @@ namespace libmpdataxx
 
         arr_t *old(arr_t *arg)
         {
+          // moving the array to memory shared with the processes on the node, whose remote bconds put halos
+          // directly into it (see remote_common::shm_put()); the contents only matter in debug builds (NaNs)
+          if (shm_arrays)
+          {
+            const std::unique_ptr<arr_t> tmp(arg);
+            real_t *data = static_cast<real_t*>(distmem.shm_alloc_arr(tmp->numElements() * sizeof(real_t)));
+            arg = new arr_t(data, tmp->shape(), blitz::neverDeleteData, blitz::GeneralArrayStorage<n_dims>(tmp->ordering(), blitz::TinyVector<bool, n_dims>(true)));
+            arg->reindexSelf(tmp->base());
+#if !defined(NDEBUG)
+            *arg = *tmp;
+#endif
+          }
+          if (numa_alloc == numa_interleave)
+            detail::numa_set_interleave(arg->dataFirst(), arg->numElements() * sizeof(real_t));
+#if defined(USE_MPI) && defined(LIBMPDATAXX_MPI_RMA)
+          // halos are put directly into the arrays of the peers by remote bconds
+          distmem.rma_attach(arg->dataFirst(), arg->numElements() * sizeof(real_t));
+#endif
           tobefreed.push_back(arg);
           arr_t *ret = this->never_delete(arg);
           return ret;
         }
 
+        // the part of an array (indexed like the grid) that belongs to the subdomain of a given thread,
+        // extended up to the bounds of the array at domain edges (i.e. including outer halos),
+        // so that the parts of all threads cover the array without overlapping; false if empty
+        bool thread_part(const arr_t &arr, const int rank, idx_t<n_dims> &idx) const
+        {
+          std::array<rng_t, n_dims> sub = grid_size;
+          sub[shmem_decomp_dim] = slab(grid_size[shmem_decomp_dim], rank / tiles[1], tiles[0]);
+          if (n_dims > 1)
+            sub[shmem_tile_dim] = slab(grid_size[shmem_tile_dim], rank % tiles[1], tiles[1]);
+
+          idx = idx_t<n_dims>(arr.lbound(), arr.ubound());
+          bool empty = false;
+          for (int d = 0; d < n_dims; ++d)
+          {
+            if (sub[d].first() != grid_size[d].first()) idx.lbound(d) = std::max(arr.lbound(d), sub[d].first());
+            if (sub[d].last()  != grid_size[d].last())  idx.ubound(d) = std::min(arr.ubound(d), sub[d].last());
+            empty = empty || idx.lbound(d) > idx.ubound(d);
+          }
+          return !empty;
+        }
+
+        // writes to the part of every allocated array that belongs to the subdomain of a given thread,
+        // to be called from within that thread so that the memory pages land on its NUMA node;
+        // the subdomains are those set up by concurr
+        // note: ineffective in debug builds, where arrays are NaN-filled by the master thread on allocation
+        void first_touch(const int &rank)
+        {
+          for (auto &arr : tobefreed)
+          {
+            idx_t<n_dims> idx;
+            if (!thread_part(arr, rank, idx)) continue;
+#if !defined(NDEBUG)
+            arr(idx) = blitz::has_signalling_NaN(real_t(0)) ? blitz::signalling_NaN(real_t(0)) : blitz::quiet_NaN(real_t(0));
+#else
+            arr(idx) = 0;
+#endif
+          }
+        }
+
         public:
         static rng_t slab(
           const rng_t &span,
@@ -300,7 +565,9 @@ namespace libmpdataxx
 #if defined(USE_MPI)
           if(this->distmem.size() > 1)
           {
-            advectee(e) = arr(slab(rng_t(0, distmem.grid_size[0]-1), distmem.rank(), distmem.size()));
+            blitz::TinyVector<rng_t, n_dims> ijk;
+            for (int d = 0; d < n_dims; ++d) ijk[d] = this->grid_size[d];
+            advectee(e) = arr(idx_t<n_dims>(ijk));
           }
           else
 #endif
@@ -344,7 +611,7 @@ namespace libmpdataxx
         {
 #if defined(USE_MPI)
           if(this->distmem.size() > 1)
-            return this->distmem.get_global_array(advectee(e), false);
+            return this->distmem.get_global_array(advectee(e));
           else
 #endif
             return advectee(e);
@@ -422,7 +689,7 @@ namespace libmpdataxx
         {
 #if defined(USE_MPI)
           if(this->distmem.size() > 1)
-            return this->distmem.get_global_array(advectee(e), false);
+            return this->distmem.get_global_array(advectee(e));
           else
 #endif
             return advectee(e);
@@ -534,7 +801,7 @@ namespace libmpdataxx
         {
 #if defined(USE_MPI)
           if(this->distmem.size() > 1)
-            return this->distmem.get_global_array(advectee(e), true);
+            return this->distmem.get_global_array(advectee(e));
           else
 #endif
             return advectee(e);
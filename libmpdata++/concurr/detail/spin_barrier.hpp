@@ -0,0 +1,90 @@
+/** @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ */
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+namespace libmpdataxx
+{
+  namespace concurr
+  {
+    namespace detail
+    {
+      // sense-reversing barrier: the arriving threads decrement a shared counter,
+      // the last one resets it and flips the shared sense flag; the others spin
+      // on the flag for a bounded number of iterations and then go to sleep
+      // on a condition variable (woken by the last thread only if anybody sleeps);
+      // spinning is disabled if there are more threads than hardware threads
+      class spin_barrier
+      {
+        static constexpr std::size_t cache_line = 64;
+
+        alignas(cache_line) std::atomic<std::size_t> m_count;
+        alignas(cache_line) std::atomic<bool> m_sense;
+        alignas(cache_line) std::atomic<std::size_t> m_sleepers;
+
+        alignas(cache_line) std::mutex m_mutex;
+        std::condition_variable m_cond;
+
+        const std::size_t m_threshold;
+        const int m_spin;
+
+        static void cpu_relax()
+        {
+#if defined(__x86_64__) || defined(__i386__)
+          __builtin_ia32_pause();
+#endif
+        }
+
+        public:
+
+        spin_barrier(const std::size_t count, const int spin) :
+          m_count(count),
+          m_sense(false),
+          m_sleepers(0),
+          m_threshold(count),
+          m_spin(count <= std::thread::hardware_concurrency() ? spin : 0)
+        { }
+
+        bool wait()
+        {
+          const bool sense = m_sense.load(std::memory_order_relaxed);
+
+          if (m_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+          {
+            m_count.store(m_threshold, std::memory_order_relaxed);
+            m_sense.store(!sense); // seq_cst, pairs with the sleepers check below
+            if (m_sleepers.load() != 0)
+            {
+              { std::lock_guard<std::mutex> lock(m_mutex); }
+              m_cond.notify_all();
+            }
+            return true;
+          }
+
+          for (int i = 0; i < m_spin; ++i)
+          {
+            if (m_sense.load(std::memory_order_acquire) != sense) return false;
+            cpu_relax();
+          }
+
+          m_sleepers.fetch_add(1);
+          {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (m_sense.load() == sense)
+              m_cond.wait(lock);
+          }
+          m_sleepers.fetch_sub(1);
+          return false;
+        }
+      };
+    } // namespace detail
+  } // namespace concurr
+} // namespace libmpdataxx
@@ -0,0 +1,118 @@
+/** @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ */
+
+#pragma once
+
+#include <boost/ptr_container/ptr_vector.hpp>
+
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+namespace libmpdataxx
+{
+  namespace concurr
+  {
+    namespace detail
+    {
+      // a set of worker threads spawned once and parked between jobs;
+      // run() hands the same job to every worker (passing its rank)
+      // and returns once all of them are done
+      // thread_t is either std::thread or boost::thread
+      template <class thread_t>
+      class thread_pool
+      {
+        boost::ptr_vector<thread_t> threads;
+
+        std::mutex m_mutex;
+        std::condition_variable m_cond_work, m_cond_done;
+        std::size_t m_generation = 0, m_pending = 0;
+        bool m_quit = false;
+
+        std::function<void(int)> job;
+        std::exception_ptr error;
+
+        void loop(const int rank, const std::function<void(int)> &init)
+        {
+          if (init) init(rank);
+
+          std::size_t gen = 0;
+          while (true)
+          {
+            {
+              std::unique_lock<std::mutex> lock(m_mutex);
+              while (gen == m_generation && !m_quit)
+                m_cond_work.wait(lock);
+              if (m_quit) return;
+              gen = m_generation;
+            }
+
+            try
+            {
+              job(rank);
+            }
+            catch (...)
+            {
+              std::lock_guard<std::mutex> lock(m_mutex);
+              if (!error) error = std::current_exception();
+            }
+
+            {
+              std::lock_guard<std::mutex> lock(m_mutex);
+              if (--m_pending == 0) m_cond_done.notify_one();
+            }
+          }
+        }
+
+        public:
+
+        int size() const
+        {
+          return threads.size();
+        }
+
+        void run(const std::function<void(int)> &fun)
+        {
+          {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            job = fun;
+            error = nullptr;
+            m_pending = threads.size();
+            m_generation++;
+          }
+          m_cond_work.notify_all();
+
+          {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (m_pending != 0)
+              m_cond_done.wait(lock);
+          }
+
+          if (error) std::rethrow_exception(error);
+        }
+
+        // ctor, init (if given) is called once by each worker when it starts (e.g. to pin it to CPUs)
+        explicit thread_pool(const int size, const std::function<void(int)> &init = {})
+        {
+          for (int i = 0; i < size; ++i)
+            threads.push_back(new thread_t(&thread_pool::loop, this, i, init));
+        }
+
+        // dtor
+        ~thread_pool()
+        {
+          {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+          }
+          m_cond_work.notify_all();
+          for (auto &th : threads) th.join();
+        }
+      };
+    } // namespace detail
+  } // namespace concurr
+} // namespace libmpdataxx
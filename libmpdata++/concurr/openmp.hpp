@@ -8,7 +8,9 @@
 
 #include <libmpdata++/concurr/detail/concurr_common.hpp>
 
+#include <atomic>
 #include <limits>
+#include <utility>
 
 #ifdef _OPENMP
 # include <omp.h>
@@ -54,14 +56,32 @@ namespace libmpdataxx
         void barrier()
         {
           // TODO: if (size() != 1) ???
+          const typename parent_t::mem_t::wait_timer wt(this->time_barriers);
 #pragma omp barrier
         }
 
         // ctors
-        mem_t(const std::array<int, solver_t::n_dims> &grid_size) : parent_t::mem_t(grid_size, size(grid_size[0])) {};
+        mem_t(const std::array<int, solver_t::n_dims> &grid_size, const int mpi_decomp_dims = 1) : parent_t::mem_t(grid_size, size(parent_t::mem_t::max_size(grid_size)), mpi_decomp_dims) {};
       };
 
       void solve(typename parent_t::advance_arg_t nt)
+      {
+        parallel([&](const int i) { this->algos[i].solve(nt); });
+      }
+
+      // OpenMP runtimes keep their threads across parallel regions, hence each thread
+      // is pinned only once (again only if it gets a different number or another instance runs it)
+      const unsigned long id = [](){ static std::atomic<unsigned long> n(0); return ++n; }();
+
+      void pin(const int i) const
+      {
+        static thread_local std::pair<unsigned long, int> pinned(0, -1);
+        if (pinned.first == id && pinned.second == i) return;
+        this->aff.pin(i);
+        pinned = {id, i};
+      }
+
+      void parallel(const std::function<void(int)> &job)
       {
         int i = 0;
 #pragma omp parallel private(i)
@@ -69,7 +89,8 @@ namespace libmpdataxx
 #if defined(_OPENMP)
           i = omp_get_thread_num();
 #endif
-          this->algos[i].solve(nt);
+          pin(i);
+          job(i);
         }
       }
 
@@ -77,8 +98,10 @@ namespace libmpdataxx
 
       // ctor
       openmp(const typename solver_t::rt_params_t &p) :
-        parent_t(p, new mem_t(p.grid_size), mem_t::size(p.grid_size[solver_t::n_dims < 3 ? 0 : 1])) // note 3D domain decomposition in y direction
-      {}
+        parent_t(p, new mem_t(p.grid_size, p.mpi_decomp_dims), mem_t::size(mem_t::max_size(p.grid_size)))
+      {
+        this->numa_init(p);
+      }
 
     };
   } // namespace concurr
@@ -33,8 +33,8 @@ namespace libmpdataxx
         void barrier() { }
 
         // ctors
-        mem_t(const std::array<int, solver_t::n_dims> &grid_size)
-          : parent_t::mem_t(grid_size, size())
+        mem_t(const std::array<int, solver_t::n_dims> &grid_size, const int mpi_decomp_dims = 1)
+          : parent_t::mem_t(grid_size, size(), mpi_decomp_dims)
         {};
       };
 
@@ -43,11 +43,16 @@ namespace libmpdataxx
         this->algos[0].solve(nt);
       }
 
+      void parallel(const std::function<void(int)> &job)
+      {
+        job(0);
+      }
+
       public:
 
       // ctor
       serial(const typename solver_t::rt_params_t &p) :
-        parent_t(p, new mem_t(p.grid_size), mem_t::size())
+        parent_t(p, new mem_t(p.grid_size, p.mpi_decomp_dims), mem_t::size())
       {}
 
     };
@@ -9,6 +9,9 @@
 #include <libmpdata++/formulae/idxperm.hpp>
 #include <libmpdata++/formulae/common.hpp>
 #include <libmpdata++/formulae/kahan_sum.hpp>
+#include <libmpdata++/formulae/simd.hpp>
+
+#include <type_traits>
 
 namespace libmpdataxx
 {
@@ -78,6 +81,79 @@ namespace libmpdataxx
         ));
       }
 
+      // F() for simd::assign()
+      template <opts_t opts>
+      inline constexpr auto F_simd = [](const auto &psi_l, const auto &psi_r, const auto &GC) {
+        return simd::pospart<opts>(GC) * psi_l + simd::negpart<opts>(GC) * psi_r;
+      };
+
+      // flx = make_flux(), in explicitly vectorised loops with LIBMPDATAXX_SIMD (see simd.hpp)
+
+      template <opts_t opts, class arr_1d_t>
+      inline void set_flux(
+        arr_1d_t &flx,
+        const arr_1d_t &psi,
+        const arr_1d_t &GC,
+        const rng_t &i
+      )
+      {
+#if defined(LIBMPDATAXX_SIMD)
+        simd::assign(flx(i+h), F_simd<opts>, psi(i), psi(i+1), GC(i+h));
+#else
+        flx(i+h) = make_flux<opts>(psi, GC, i);
+#endif
+      }
+
+      template <opts_t opts, int d, class arr_2d_t>
+      inline void set_flux(
+        arr_2d_t &flx,
+        const arr_2d_t &psi,
+        const arr_2d_t &GC,
+        const rng_t &i,
+        const rng_t &j
+      )
+      {
+#if defined(LIBMPDATAXX_SIMD)
+        simd::assign(flx(pi<d>(i+h, j)), F_simd<opts>, psi(pi<d>(i, j)), psi(pi<d>(i+1, j)), GC(pi<d>(i+h, j)));
+#else
+        flx(pi<d>(i+h, j)) = make_flux<opts, d>(psi, GC, i, j);
+#endif
+      }
+
+      template <opts_t opts, int d, class arr_3d_t>
+      inline void set_flux(
+        arr_3d_t &flx,
+        const arr_3d_t &psi,
+        const arr_3d_t &GC,
+        const rng_t &i,
+        const rng_t &j,
+        const rng_t &k
+      )
+      {
+#if defined(LIBMPDATAXX_SIMD)
+        simd::assign(flx(pi<d>(i+h, j, k)), F_simd<opts>, psi(pi<d>(i, j, k)), psi(pi<d>(i+1, j, k)), GC(pi<d>(i+h, j, k)));
+#else
+        flx(pi<d>(i+h, j, k)) = make_flux<opts, d>(psi, GC, i, j, k);
+#endif
+      }
+
+      // the donor-cell sums below in explicitly vectorised loops (see simd.hpp), without Kahan summation
+      // and with the fluxes and G given as arrays (or G as a number)
+      template <opts_t opts, class a_t, class g_t, class... f_t>
+      constexpr bool simd_sum =
+        !opts::isset(opts, opts::khn) && (std::is_same<f_t, a_t>::value && ...) &&
+        (std::is_arithmetic<g_t>::value || std::is_same<g_t, a_t>::value);
+
+      // psi_new = psi_old + sum(flx...) / g
+      template <class a_t, class g_t, class sum_t, class... f_t>
+      inline void donorcell_sum_simd(const a_t &psi_new, const a_t &psi_old, const g_t &g, const sum_t &sum, const f_t &... flx)
+      {
+        if constexpr (std::is_arithmetic<g_t>::value)
+          simd::assign(psi_new, [&](const auto &old, const auto &... f) { return old + sum(f...) / g; }, psi_old, flx...);
+        else
+          simd::assign(psi_new, [&](const auto &old, const auto &gg, const auto &... f) { return old + sum(f...) / gg; }, psi_old, g, flx...);
+      }
+
       template <opts_t opts, class a_t, class f1_t, class f2_t, class g_t>
       inline void donorcell_sum(
         const arrvec_t<a_t> &khn_tmp,
@@ -89,6 +165,16 @@ namespace libmpdataxx
         const g_t &g
       )
       {
+#if defined(LIBMPDATAXX_SIMD)
+        if constexpr (simd_sum<opts, a_t, g_t, f1_t, f2_t>)
+        {
+          donorcell_sum_simd(psi_new, psi_old, g,
+            [](const auto &f1, const auto &f2) { return -f1 + f2; },
+            flx_1, flx_2
+          );
+          return;
+        }
+#endif
         if (!opts::isset(opts, opts::khn))
         {
           psi_new = psi_old + (-flx_1 + flx_2) / g;
@@ -115,6 +201,16 @@ namespace libmpdataxx
         const g_t &g
       )
       {
+#if defined(LIBMPDATAXX_SIMD)
+        if constexpr (simd_sum<opts, a_t, g_t, f1_t, f2_t, f3_t, f4_t>)
+        {
+          donorcell_sum_simd(psi_new, psi_old, g,
+            [](const auto &f1, const auto &f2, const auto &f3, const auto &f4) { return (-f1 + f2) + (-f3 + f4); },
+            flx_1, flx_2, flx_3, flx_4
+          );
+          return;
+        }
+#endif
         if (!opts::isset(opts, opts::khn))
         {
           // note: the parentheses are intended to minimise chances of numerical errors
@@ -146,6 +242,18 @@ namespace libmpdataxx
         const g_t &g
       )
       {
+#if defined(LIBMPDATAXX_SIMD)
+        if constexpr (simd_sum<opts, a_t, g_t, f1_t, f2_t, f3_t, f4_t, f5_t, f6_t>)
+        {
+          donorcell_sum_simd(psi_new, psi_old, g,
+            [](const auto &f1, const auto &f2, const auto &f3, const auto &f4, const auto &f5, const auto &f6) {
+              return (-f1 + f2) + (-f3 + f4) + (-f5 + f6);
+            },
+            flx_1, flx_2, flx_3, flx_4, flx_5, flx_6
+          );
+          return;
+        }
+#endif
         if (!opts::isset(opts, opts::khn))
         {
           // note: the parentheses are intended to minimise chances of numerical errors
@@ -195,6 +195,19 @@ namespace libmpdataxx
         typename std::enable_if<!opts::isset(opts, opts::div_2nd) && !opts::isset(opts, opts::div_3rd)>::type* = 0
       )
       {
+#if defined(LIBMPDATAXX_SIMD)
+        if constexpr (simd_antidiff<opts>)
+        {
+          using real_t = typename arr_1d_t::T_numtype;
+          simd::assign(res(ir+h),
+            [](const auto &gc, const auto &psi_r, const auto &psi_l) {
+              return simd::absval(gc) / 2 * (1 - simd::absval(gc)) * ndx_psi_simd<opts, real_t>(psi_r, psi_l);
+            },
+            GC[0](ir+h), psi(ir+1), psi(ir)
+          );
+          return;
+        }
+#endif
         for (int i = ir.first(); i <= ir.last(); ++i)
         {
           res(i) =
@@ -253,6 +253,26 @@ namespace libmpdataxx
         typename std::enable_if<!opts::isset(opts, opts::div_2nd) && !opts::isset(opts, opts::div_3rd)>::type* = 0
       )
       {
+#if defined(LIBMPDATAXX_SIMD)
+        if constexpr (simd_antidiff<opts>)
+        {
+          using real_t = typename arr_2d_t::T_numtype;
+          simd::assign(res(pi<dim>(ir+h, jr)),
+            [](
+              const auto &gc, const auto &psi_r, const auto &psi_l,
+              const auto &gc1_ru, const auto &gc1_lu, const auto &gc1_rd, const auto &gc1_ld,
+              const auto &psi_ru, const auto &psi_lu, const auto &psi_rd, const auto &psi_ld
+            ) {
+              return simd::absval(gc) / 2 * (1 - simd::absval(gc)) * ndx_psi_simd<opts, real_t>(psi_r, psi_l)
+                - gc * ((gc1_ru + gc1_lu + gc1_rd + gc1_ld) / 4) / 2 * ndy_psi_simd<opts, real_t>(psi_ru, psi_lu, psi_rd, psi_ld);
+            },
+            GC[dim](pi<dim>(ir+h, jr)), psi_np1(pi<dim>(ir+1, jr)), psi_np1(pi<dim>(ir, jr)),
+            GC[dim+1](pi<dim>(ir+1, jr+h)), GC[dim+1](pi<dim>(ir, jr+h)), GC[dim+1](pi<dim>(ir+1, jr-h)), GC[dim+1](pi<dim>(ir, jr-h)),
+            psi_np1(pi<dim>(ir+1, jr+1)), psi_np1(pi<dim>(ir, jr+1)), psi_np1(pi<dim>(ir+1, jr-1)), psi_np1(pi<dim>(ir, jr-1))
+          );
+          return;
+        }
+#endif
         for (int i = ir.first(); i <= ir.last(); ++i)
         {
           for (int j = jr.first(); j <= jr.last(); ++j)
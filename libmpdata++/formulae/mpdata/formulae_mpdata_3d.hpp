@@ -266,6 +266,33 @@ namespace libmpdataxx
         typename std::enable_if<!opts::isset(opts, opts::div_2nd) && !opts::isset(opts, opts::div_3rd)>::type* = 0
       )
       {
+#if defined(LIBMPDATAXX_SIMD)
+        if constexpr (simd_antidiff<opts>)
+        {
+          using real_t = typename arr_3d_t::T_numtype;
+          simd::assign(res(pi<dim>(ir+h, jr, kr)),
+            [](
+              const auto &gc, const auto &psi_r, const auto &psi_l,
+              const auto &gc1_ru, const auto &gc1_lu, const auto &gc1_rd, const auto &gc1_ld,
+              const auto &gc2_ru, const auto &gc2_lu, const auto &gc2_rd, const auto &gc2_ld,
+              const auto &psi1_ru, const auto &psi1_lu, const auto &psi1_rd, const auto &psi1_ld,
+              const auto &psi2_ru, const auto &psi2_lu, const auto &psi2_rd, const auto &psi2_ld
+            ) {
+              return simd::absval(gc) / 2 * (1 - simd::absval(gc)) * ndx_psi_simd<opts, real_t>(psi_r, psi_l)
+                - gc / 2 * (
+                    (gc1_ru + gc1_lu + gc1_rd + gc1_ld) / 4 * ndy_psi_simd<opts, real_t>(psi1_ru, psi1_lu, psi1_rd, psi1_ld)
+                  + (gc2_ru + gc2_lu + gc2_rd + gc2_ld) / 4 * ndy_psi_simd<opts, real_t>(psi2_ru, psi2_lu, psi2_rd, psi2_ld)
+                );
+            },
+            GC[dim](pi<dim>(ir+h, jr, kr)), psi_np1(pi<dim>(ir+1, jr, kr)), psi_np1(pi<dim>(ir, jr, kr)),
+            GC[dim+1](pi<dim>(ir+1, jr+h, kr)), GC[dim+1](pi<dim>(ir, jr+h, kr)), GC[dim+1](pi<dim>(ir+1, jr-h, kr)), GC[dim+1](pi<dim>(ir, jr-h, kr)),
+            GC[dim-1](pi<dim>(ir+1, jr, kr+h)), GC[dim-1](pi<dim>(ir, jr, kr+h)), GC[dim-1](pi<dim>(ir+1, jr, kr-h)), GC[dim-1](pi<dim>(ir, jr, kr-h)),
+            psi_np1(pi<dim>(ir+1, jr+1, kr)), psi_np1(pi<dim>(ir, jr+1, kr)), psi_np1(pi<dim>(ir+1, jr-1, kr)), psi_np1(pi<dim>(ir, jr-1, kr)),
+            psi_np1(pi<dim>(ir+1, jr, kr+1)), psi_np1(pi<dim>(ir, jr, kr+1)), psi_np1(pi<dim>(ir+1, jr, kr-1)), psi_np1(pi<dim>(ir, jr, kr-1))
+          );
+          return;
+        }
+#endif
         for (int i = ir.first(); i <= ir.last(); ++i)
         {
           for (int j = jr.first(); j <= jr.last(); ++j)
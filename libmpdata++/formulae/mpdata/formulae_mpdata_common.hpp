@@ -10,6 +10,7 @@
 #include <libmpdata++/formulae/idxperm.hpp>
 #include <libmpdata++/formulae/arakawa_c.hpp>
 #include <libmpdata++/formulae/common.hpp>
+#include <libmpdata++/formulae/simd.hpp>
 
 //#include <boost/preprocessor/control/if.hpp>
 
@@ -96,6 +97,47 @@ namespace libmpdataxx
           nom / (den + blitz::epsilon(typename real_t_helper<ix_t, nom_t>::type(0.)))
         );
       }
+
+      // the standard antidiffusive velocities without the higher-order and divergent-flow terms and with G = 1
+      // are computed in explicitly vectorised loops with LIBMPDATAXX_SIMD (see simd.hpp), using the following
+      template <opts_t opts>
+      constexpr bool simd_antidiff =
+        !opts::isset(opts, opts::tot) && !opts::isset(opts, opts::fot) && !opts::isset(opts, opts::dfl) &&
+        !opts::isset(opts, opts::nug) && !opts::isset(opts, opts::div_2nd) && !opts::isset(opts, opts::div_3rd) &&
+        !opts::isset(opts, opts::div_3rd_dt);
+
+      // ndx_psi() from psi at i+1 and i
+      template <opts_t opts, class real_t, class x_t>
+      forceinline_macro x_t ndx_psi_simd(const x_t &psi_r, const x_t &psi_l)
+      {
+        if constexpr (opts::isset(opts, opts::iga))
+          return 2 * (psi_r - psi_l) / (1 + 1);
+        else if constexpr (opts::isset(opts, opts::abs))
+        {
+          const x_t r = simd::absval(psi_r), l = simd::absval(psi_l);
+          return 2 * simd::frac<opts::isset(opts, opts::pfc), real_t>(x_t(r - l), x_t(r + l));
+        }
+        else
+          return 2 * simd::frac<opts::isset(opts, opts::pfc), real_t>(x_t(psi_r - psi_l), x_t(psi_r + psi_l));
+      }
+
+      // ndy_psi() (and ndz_psi()) from psi at (i+1, j+1), (i, j+1), (i+1, j-1) and (i, j-1)
+      template <opts_t opts, class real_t, class x_t>
+      forceinline_macro x_t ndy_psi_simd(const x_t &psi_ru, const x_t &psi_lu, const x_t &psi_rd, const x_t &psi_ld)
+      {
+        if constexpr (opts::isset(opts, opts::iga))
+          return (psi_ru + psi_lu - psi_rd - psi_ld) / (1 + 1 + 1 + 1);
+        else if constexpr (opts::isset(opts, opts::abs))
+        {
+          const x_t ru = simd::absval(psi_ru), lu = simd::absval(psi_lu), rd = simd::absval(psi_rd), ld = simd::absval(psi_ld);
+          return simd::frac<opts::isset(opts, opts::pfc), real_t>(x_t(ru + lu - rd - ld), x_t(ru + lu + rd + ld));
+        }
+        else
+          return simd::frac<opts::isset(opts, opts::pfc), real_t>(
+            x_t(psi_ru + psi_lu - psi_rd - psi_ld),
+            x_t(psi_ru + psi_lu + psi_rd + psi_ld)
+          );
+      }
     } // namespace mpdata
   } // namespace formulae
 } // namespcae libmpdataxx
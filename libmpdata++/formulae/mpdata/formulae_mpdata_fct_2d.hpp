@@ -38,36 +38,6 @@ namespace libmpdataxx
         );
       }
 
-      template <opts_t opts, class arr_2d_t, class flx_t>
-      forceinline_macro void beta_up(
-        arr_2d_t &b,
-        const arr_2d_t &psi,
-        const arr_2d_t &psi_max, // from before the first iteration
-        const flx_t &flx,
-        const arr_2d_t &G,
-        const rng_t &ir,
-        const rng_t &jr
-      )
-      {
-        using ix_t = int;
-        for (int i = ir.first(); i <= ir.last(); ++i)
-        {
-          for (int j = jr.first(); j <= jr.last(); ++j)
-          {
-            b(i, j) =
-            fct_frac<ix_t>(
-              beta_up_nominator<opts>(psi, psi_max, G, i, j)
-              , // -----------------------------------------------------------
-              ( pospart<opts, ix_t>(flx[0](i-h, j))
-              - negpart<opts, ix_t>(flx[0](i+h, j)) )  // additional parenthesis so that we first sum
-              +                                                        // fluxes in separate dimensions
-              ( pospart<opts, ix_t>(flx[1](i, j-h))    // could be important for accuracy if one of them
-              - negpart<opts, ix_t>(flx[1](i, j+h)) )  // is of different magnitude than the other
-            );
-          }
-        }
-      }
-
       template <opts_t opts, class arr_2d_t, class ix_t>
       forceinline_macro auto beta_dn_nominator(
         const arr_2d_t &psi,
@@ -89,34 +59,127 @@ namespace libmpdataxx
         );
       }
 
+      // psi_min and psi_max (the bounds used by beta_up_nominator() and beta_dn_nominator())
+      // computed together in a single pass over the cells
+      template <class arr_2d_t>
+      forceinline_macro void psi_min_max(
+        arr_2d_t &psi_min,
+        arr_2d_t &psi_max,
+        const arr_2d_t &psi,
+        const rng_t &ir,
+        const rng_t &jr
+      )
+      {
+#if defined(LIBMPDATAXX_SIMD)
+        simd::assign2(psi_min(ir, jr), psi_max(ir, jr),
+          [](const auto &c, const auto &... nbr) {
+            using x_t = std::decay_t<decltype(c)>;
+            return std::array<x_t, 2>{simd::minval(c, nbr...), simd::maxval(c, nbr...)};
+          },
+          psi(ir, jr),
+          psi(ir+1, jr), psi(ir-1, jr),
+          psi(ir, jr+1), psi(ir, jr-1)
+        );
+#else
+        using ix_t = int;
+        for (int i = ir.first(); i <= ir.last(); ++i)
+        {
+          for (int j = jr.first(); j <= jr.last(); ++j)
+          {
+            psi_min(i, j) = min<ix_t>(
+                           psi(i, j+1),
+              psi(i-1, j), psi(i, j  ), psi(i+1, j),
+                           psi(i, j-1)
+            );
+            psi_max(i, j) = max<ix_t>(
+                           psi(i, j+1),
+              psi(i-1, j), psi(i, j  ), psi(i+1, j),
+                           psi(i, j-1)
+            );
+          }
+        }
+#endif
+      }
+
+      // beta_up and beta_dn computed together in a single pass over the cells
       template <opts_t opts, class arr_2d_t, class flx_t>
-      forceinline_macro auto beta_dn(
-        arr_2d_t &b,
+      forceinline_macro void beta(
+        arr_2d_t &b_up,
+        arr_2d_t &b_dn,
         const arr_2d_t &psi,
         const arr_2d_t &psi_min, // from before the first iteration
+        const arr_2d_t &psi_max, // ditto
         const flx_t &flx,
         const arr_2d_t &G,
         const rng_t &ir,
         const rng_t &jr
       )
       {
+#if defined(LIBMPDATAXX_SIMD)
+        using real_t = typename arr_2d_t::T_numtype;
+        const auto betas = [&](const auto &... g) { // G with nug, none otherwise
+          simd::assign2(b_up(ir, jr), b_dn(ir, jr),
+            [](
+              const auto &c, const auto &mn, const auto &mx,
+              const auto &ip, const auto &im, const auto &jp, const auto &jm,
+              const auto &fxl, const auto &fxr, const auto &fyl, const auto &fyr,
+              const auto &... gg
+            ) {
+              using x_t = std::decay_t<decltype(c)>;
+              return std::array<x_t, 2>{
+                simd::fct_frac<real_t>(
+                  x_t(((simd::maxval(mx, c, ip, im, jp, jm) - c) * ... * gg)),
+                  x_t(
+                    (simd::pospart<opts>(fxl) - simd::negpart<opts>(fxr)) + // summed as in the loops below
+                    (simd::pospart<opts>(fyl) - simd::negpart<opts>(fyr))
+                  )
+                ),
+                simd::fct_frac<real_t>(
+                  x_t(((c - simd::minval(mn, c, ip, im, jp, jm)) * ... * gg)),
+                  x_t(
+                    (simd::pospart<opts>(fxr) - simd::negpart<opts>(fxl)) +
+                    (simd::pospart<opts>(fyr) - simd::negpart<opts>(fyl))
+                  )
+                )
+              };
+            },
+            psi(ir, jr), psi_min(ir, jr), psi_max(ir, jr),
+            psi(ir+1, jr), psi(ir-1, jr),
+            psi(ir, jr+1), psi(ir, jr-1),
+            flx[0](ir-h, jr), flx[0](ir+h, jr),
+            flx[1](ir, jr-h), flx[1](ir, jr+h),
+            g...
+          );
+        };
+        if constexpr (opts::isset(opts, opts::nug)) betas(G(ir, jr));
+        else betas();
+#else
         using ix_t = int;
         for (int i = ir.first(); i <= ir.last(); ++i)
         {
           for (int j = jr.first(); j <= jr.last(); ++j)
           {
-            b(i, j) =
-            fct_frac<ix_t>(
+            b_up(i, j) = fct_frac<ix_t>(
+              beta_up_nominator<opts>(psi, psi_max, G, i, j)
+              , // -----------------------------------------------------------
+              ( pospart<opts, ix_t>(flx[0](i-h, j))
+              - negpart<opts, ix_t>(flx[0](i+h, j)) )  // additional parenthesis so that we first sum
+              +                                        // fluxes in separate dimensions
+              ( pospart<opts, ix_t>(flx[1](i, j-h))    // could be important for accuracy if one of them
+              - negpart<opts, ix_t>(flx[1](i, j+h)) )  // is of different magnitude than the other
+            );
+            b_dn(i, j) = fct_frac<ix_t>(
               beta_dn_nominator<opts>(psi, psi_min, G, i, j)
-              , // ---------------------------------------------------------
+              , // -----------------------------------------------------------
               ( pospart<opts, ix_t>(flx[0](i+h, j))
-              - negpart<opts, ix_t>(flx[0](i-h, j)) )  //see note in positive sign beta up
+              - negpart<opts, ix_t>(flx[0](i-h, j)) )  // see note in beta up
               +
               ( pospart<opts, ix_t>(flx[1](i, j+h))
               - negpart<opts, ix_t>(flx[1](i, j-h)) )
             );
           }
         }
+#endif
       }
 
       template <opts_t opts, int d, class arr_2d_t>
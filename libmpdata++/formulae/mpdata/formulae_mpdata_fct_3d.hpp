@@ -44,43 +44,6 @@ namespace libmpdataxx
         );
       }
 
-      template <opts_t opts, class arr_3d_t, class flx_t>
-      forceinline_macro void beta_up(
-        arr_3d_t &b,
-        const arr_3d_t &psi,
-        const arr_3d_t &psi_max, // from before the first iteration
-        const flx_t &flx,
-        const arr_3d_t &G,
-        const rng_t &ir,
-        const rng_t &jr,
-        const rng_t &kr
-      )
-      {
-        using ix_t = int;
-        for (int i = ir.first(); i <= ir.last(); ++i)
-        {
-          for (int j = jr.first(); j <= jr.last(); ++j)
-          {
-            for (int k = kr.first(); k <= kr.last(); ++k)
-            {
-              b(i, j, k) =
-              fct_frac<ix_t>(
-                beta_up_nominator<opts>(psi, psi_max, G, i, j, k)
-                , //-------------------------------------------------------------------------------------
-                ( pospart<opts, ix_t>(flx[0](i-h, j, k))
-                - negpart<opts, ix_t>(flx[0](i+h, j, k)) )  // additional parenthesis so that we first sum
-                +                                           // fluxes in separate dimensions
-                ( pospart<opts, ix_t>(flx[1](i, j-h, k))    // could be important for accuracy if one of them
-                - negpart<opts, ix_t>(flx[1](i, j+h, k)) )  // is of different magnitude than the other
-                +                                           // fluxes in separate dimensions
-                ( pospart<opts, ix_t>(flx[2](i, j, k-h))
-                - negpart<opts, ix_t>(flx[2](i, j, k+h)) )
-              );
-            }
-          }
-        }
-      }
-
       template <opts_t opts, class arr_3d_t, class ix_t>
       forceinline_macro auto beta_dn_nominator(
         const arr_3d_t &psi,
@@ -107,11 +70,64 @@ namespace libmpdataxx
         );
       }
 
+      // psi_min and psi_max (the bounds used by beta_up_nominator() and beta_dn_nominator())
+      // computed together in a single pass over the cells
+      template <class arr_3d_t>
+      forceinline_macro void psi_min_max(
+        arr_3d_t &psi_min,
+        arr_3d_t &psi_max,
+        const arr_3d_t &psi,
+        const rng_t &ir,
+        const rng_t &jr,
+        const rng_t &kr
+      )
+      {
+#if defined(LIBMPDATAXX_SIMD)
+        simd::assign2(psi_min(ir, jr, kr), psi_max(ir, jr, kr),
+          [](const auto &c, const auto &... nbr) {
+            using x_t = std::decay_t<decltype(c)>;
+            return std::array<x_t, 2>{simd::minval(c, nbr...), simd::maxval(c, nbr...)};
+          },
+          psi(ir, jr, kr),
+          psi(ir+1, jr, kr), psi(ir-1, jr, kr),
+          psi(ir, jr+1, kr), psi(ir, jr-1, kr),
+          psi(ir, jr, kr+1), psi(ir, jr, kr-1)
+        );
+#else
+        using ix_t = int;
+        // in the order of arr3D_storage (k,i,j)
+        for (int j = jr.first(); j <= jr.last(); ++j)
+        {
+          for (int i = ir.first(); i <= ir.last(); ++i)
+          {
+            for (int k = kr.first(); k <= kr.last(); ++k)
+            {
+              psi_min(i, j, k) = min<ix_t>(
+                psi(i, j, k),
+                psi(i+1, j, k), psi(i-1, j, k),
+                psi(i, j+1, k), psi(i, j-1, k),
+                psi(i, j, k+1), psi(i, j, k-1)
+              );
+              psi_max(i, j, k) = max<ix_t>(
+                psi(i, j, k),
+                psi(i+1, j, k), psi(i-1, j, k),
+                psi(i, j+1, k), psi(i, j-1, k),
+                psi(i, j, k+1), psi(i, j, k-1)
+              );
+            }
+          }
+        }
+#endif
+      }
+
+      // beta_up and beta_dn computed together in a single pass over the cells
       template <opts_t opts, class arr_3d_t, class flx_t>
-      forceinline_macro void beta_dn(
-        arr_3d_t &b,
+      forceinline_macro void beta(
+        arr_3d_t &b_up,
+        arr_3d_t &b_dn,
         const arr_3d_t &psi,
         const arr_3d_t &psi_min, // from before the first iteration
+        const arr_3d_t &psi_max, // ditto
         const flx_t &flx,
         const arr_3d_t &G,
         const rng_t &ir,
@@ -119,19 +135,74 @@ namespace libmpdataxx
         const rng_t &kr
       )
       {
+#if defined(LIBMPDATAXX_SIMD)
+        using real_t = typename arr_3d_t::T_numtype;
+        const auto betas = [&](const auto &... g) { // G with nug, none otherwise
+          simd::assign2(b_up(ir, jr, kr), b_dn(ir, jr, kr),
+            [](
+              const auto &c, const auto &mn, const auto &mx,
+              const auto &ip, const auto &im, const auto &jp, const auto &jm, const auto &kp, const auto &km,
+              const auto &fxl, const auto &fxr, const auto &fyl, const auto &fyr, const auto &fzl, const auto &fzr,
+              const auto &... gg
+            ) {
+              using x_t = std::decay_t<decltype(c)>;
+              return std::array<x_t, 2>{
+                simd::fct_frac<real_t>(
+                  x_t(((simd::maxval(mx, c, ip, im, jp, jm, kp, km) - c) * ... * gg)),
+                  x_t(
+                    (simd::pospart<opts>(fxl) - simd::negpart<opts>(fxr)) + // summed as in the loops below
+                    (simd::pospart<opts>(fyl) - simd::negpart<opts>(fyr)) +
+                    (simd::pospart<opts>(fzl) - simd::negpart<opts>(fzr))
+                  )
+                ),
+                simd::fct_frac<real_t>(
+                  x_t(((c - simd::minval(mn, c, ip, im, jp, jm, kp, km)) * ... * gg)),
+                  x_t(
+                    (simd::pospart<opts>(fxr) - simd::negpart<opts>(fxl)) +
+                    (simd::pospart<opts>(fyr) - simd::negpart<opts>(fyl)) +
+                    (simd::pospart<opts>(fzr) - simd::negpart<opts>(fzl))
+                  )
+                )
+              };
+            },
+            psi(ir, jr, kr), psi_min(ir, jr, kr), psi_max(ir, jr, kr),
+            psi(ir+1, jr, kr), psi(ir-1, jr, kr),
+            psi(ir, jr+1, kr), psi(ir, jr-1, kr),
+            psi(ir, jr, kr+1), psi(ir, jr, kr-1),
+            flx[0](ir-h, jr, kr), flx[0](ir+h, jr, kr),
+            flx[1](ir, jr-h, kr), flx[1](ir, jr+h, kr),
+            flx[2](ir, jr, kr-h), flx[2](ir, jr, kr+h),
+            g...
+          );
+        };
+        if constexpr (opts::isset(opts, opts::nug)) betas(G(ir, jr, kr));
+        else betas();
+#else
         using ix_t = int;
-        for (int i = ir.first(); i <= ir.last(); ++i)
+        // in the order of arr3D_storage (k,i,j)
+        for (int j = jr.first(); j <= jr.last(); ++j)
         {
-          for (int j = jr.first(); j <= jr.last(); ++j)
+          for (int i = ir.first(); i <= ir.last(); ++i)
           {
             for (int k = kr.first(); k <= kr.last(); ++k)
             {
-              b(i, j, k) =
-              fct_frac<ix_t>(
+              b_up(i, j, k) = fct_frac<ix_t>(
+                beta_up_nominator<opts>(psi, psi_max, G, i, j, k)
+                , // -----------------------------------------------------------
+                ( pospart<opts, ix_t>(flx[0](i-h, j, k))
+                - negpart<opts, ix_t>(flx[0](i+h, j, k)) )  // additional parenthesis so that we first sum
+                +                                           // fluxes in separate dimensions
+                ( pospart<opts, ix_t>(flx[1](i, j-h, k))    // could be important for accuracy if one of them
+                - negpart<opts, ix_t>(flx[1](i, j+h, k)) )  // is of different magnitude than the other
+                +
+                ( pospart<opts, ix_t>(flx[2](i, j, k-h))
+                - negpart<opts, ix_t>(flx[2](i, j, k+h)) )
+              );
+              b_dn(i, j, k) = fct_frac<ix_t>(
                 beta_dn_nominator<opts>(psi, psi_min, G, i, j, k)
-                , //-----------------------------------------------------------------------------------
+                , // -----------------------------------------------------------
                 ( pospart<opts, ix_t>(flx[0](i+h, j, k))
-                - negpart<opts, ix_t>(flx[0](i-h, j, k)) )  //see note in beta up
+                - negpart<opts, ix_t>(flx[0](i-h, j, k)) )  // see note in beta up
                 +
                 ( pospart<opts, ix_t>(flx[1](i, j+h, k))
                 - negpart<opts, ix_t>(flx[1](i, j-h, k)) )
@@ -142,6 +213,7 @@ namespace libmpdataxx
             }
           }
         }
+#endif
       }
 
       template <opts_t opts, int d, class arr_3d_t>
@@ -0,0 +1,248 @@
+/** @file
+* @copyright University of Warsaw
+* @section LICENSE
+* GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+*/
+
+// explicitly vectorised loops used instead of Blitz++ expressions by some of the formulae
+// (donor-cell fluxes and sums, standard antidiffusive velocities, FCT bounds and betas) if LIBMPDATAXX_SIMD is defined;
+// vectors of std::experimental::simd if available, single values (i.e. plain loops) otherwise
+
+#pragma once
+
+#include <libmpdata++/blitz.hpp>
+#include <libmpdata++/opts.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+
+#if defined(LIBMPDATAXX_SIMD) && __has_include(<experimental/simd>)
+#  include <experimental/simd>
+#  define LIBMPDATAXX_STDX_SIMD
+#endif
+
+namespace libmpdataxx
+{
+  namespace formulae
+  {
+    namespace simd
+    {
+#if defined(LIBMPDATAXX_STDX_SIMD)
+      namespace stdx = std::experimental;
+
+      template <class real_t>
+      using vec_t = stdx::native_simd<real_t>;
+
+      template <class real_t>
+      forceinline_macro vec_t<real_t> load(const real_t *p) { return vec_t<real_t>(p, stdx::element_aligned); }
+
+      template <class real_t>
+      forceinline_macro void store(const vec_t<real_t> &v, real_t *p) { v.copy_to(p, stdx::element_aligned); }
+
+      // storing at addresses aligned to whole vectors (see peel())
+      template <class real_t>
+      forceinline_macro void store_aligned(const vec_t<real_t> &v, real_t *p) { v.copy_to(p, stdx::vector_aligned); }
+
+      // the number of elements before the first one at an address aligned to whole vectors
+      template <class real_t>
+      forceinline_macro int peel(const real_t *p)
+      {
+        constexpr std::size_t align = stdx::memory_alignment_v<vec_t<real_t>>;
+        const std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(p);
+        assert(addr % alignof(real_t) == 0);
+        return ((align - addr % align) % align) / sizeof(real_t);
+      }
+
+      template <class real_t, class abi_t>
+      forceinline_macro stdx::simd<real_t, abi_t> select(
+        const stdx::simd_mask<real_t, abi_t> &c,
+        const stdx::simd<real_t, abi_t> &a,
+        const stdx::simd<real_t, abi_t> &b
+      )
+      {
+        auto ret = b;
+        where(c, ret) = a;
+        return ret;
+      }
+#else
+      template <class real_t>
+      using vec_t = real_t;
+
+      template <class real_t>
+      forceinline_macro real_t load(const real_t *p) { return *p; }
+
+      template <class real_t>
+      forceinline_macro void store(const real_t &v, real_t *p) { *p = v; }
+
+      template <class real_t>
+      forceinline_macro void store_aligned(const real_t &v, real_t *p) { *p = v; }
+
+      template <class real_t>
+      forceinline_macro int peel(const real_t *) { return 0; }
+#endif
+
+      template <class real_t>
+      constexpr int width()
+      {
+#if defined(LIBMPDATAXX_STDX_SIMD)
+        return vec_t<real_t>::size();
+#else
+        return 1;
+#endif
+      }
+
+      // the same for single values and vectors (found by ADL for the latter)
+      template <class real_t>
+      forceinline_macro real_t select(const bool c, const real_t &a, const real_t &b) { return c ? a : b; }
+
+      template <class x_t>
+      forceinline_macro x_t absval(const x_t &x) { using std::abs; return abs(x); }
+
+      // as formulae::pospart() and formulae::negpart(), i.e. using abs with npa
+      template <opts::opts_t opts, class x_t>
+      forceinline_macro x_t pospart(const x_t &x)
+      {
+        using std::max;
+        if constexpr (opts::isset(opts, opts::npa)) return (x + absval(x)) / 2;
+        else return max(x_t(0), x);
+      }
+
+      template <opts::opts_t opts, class x_t>
+      forceinline_macro x_t negpart(const x_t &x)
+      {
+        using std::min;
+        if constexpr (opts::isset(opts, opts::npa)) return (x - absval(x)) / 2;
+        else return min(x_t(0), x);
+      }
+
+      // as formulae::mpdata::frac()
+      template <bool pfc, class real_t, class x_t>
+      forceinline_macro x_t frac(const x_t &nom, const x_t &den)
+      {
+        if constexpr (pfc) return select(den != 0, x_t(nom / den), x_t(0));
+        else return nom / (den + std::numeric_limits<real_t>::min()); // i.e. blitz::tiny()
+      }
+
+      // as formulae::mpdata::fct_frac() (the same with and without pfc, no select() needed)
+      template <class real_t, class x_t>
+      forceinline_macro x_t fct_frac(const x_t &nom, const x_t &den)
+      {
+        return nom / (den + std::numeric_limits<real_t>::epsilon()); // i.e. blitz::epsilon()
+      }
+
+      // the smallest and the largest of the arguments
+      template <class x_t, class... xs_t>
+      forceinline_macro x_t minval(const x_t &x, const xs_t &... xs)
+      {
+        using std::min;
+        if constexpr (sizeof...(xs) == 0) return x;
+        else return min(x, x_t(minval(xs...)));
+      }
+
+      template <class x_t, class... xs_t>
+      forceinline_macro x_t maxval(const x_t &x, const xs_t &... xs)
+      {
+        using std::max;
+        if constexpr (sizeof...(xs) == 0) return x;
+        else return max(x, x_t(maxval(xs...)));
+      }
+
+      // outs = fun(in...) with fun returning a std::array of n_out values, see assign() and assign2() below
+      template <class real_t, int n_dims, std::size_t n_out, class fun_t, class... in_t>
+      void assign_n(const std::array<const blitz::Array<real_t, n_dims>*, n_out> &outs, const fun_t &fun, const in_t &... in)
+      {
+        const auto &out = *outs[0];
+        const int inner = out.ordering(0);
+#if !defined(NDEBUG)
+        for (const auto *o : outs)
+        {
+          assert(o->ordering(0) == inner && o->stride(inner) == 1);
+          for (int d = 0; d < n_dims; ++d) assert(o->extent(d) == out.extent(d) && "arrays of different shapes");
+        }
+        assert(((in.ordering(0) == inner && in.stride(inner) == 1) && ...));
+        for (int d = 0; d < n_dims; ++d)
+          assert(((in.extent(d) == out.extent(d)) && ...) && "arrays of different shapes");
+#endif
+
+        constexpr int w = width<real_t>();
+        const int n = out.extent(inner);
+        int n_rows = 1;
+        for (int d = 0; d < n_dims; ++d) if (d != inner) n_rows *= out.extent(d);
+
+        // rows of all arrays at the same offsets from their first elements
+        const auto row = [&](const auto &a, const blitz::TinyVector<int, n_dims> &off) {
+          const real_t *p = a.dataFirst();
+          for (int d = 0; d < n_dims; ++d) p += off(d) * a.stride(d);
+          return const_cast<real_t*>(p);
+        };
+
+        for (int r = 0; r < n_rows; ++r)
+        {
+          blitz::TinyVector<int, n_dims> off(0);
+          for (int o = 1, rem = r; o < n_dims; ++o)
+          {
+            const int d = out.ordering(o);
+            off(d) = rem % out.extent(d);
+            rem /= out.extent(d);
+          }
+
+          std::array<real_t*, n_out> po;
+          bool aligned = true; // all outs aligned at the same element
+          for (std::size_t o = 0; o < n_out; ++o)
+          {
+            po[o] = row(*outs[o], off);
+            aligned = aligned && peel(po[o]) == peel(po[0]);
+          }
+          const auto pin = std::make_tuple(row(in, off)...);
+
+          const auto scalar = [&](const int i) {
+            const auto v = std::apply([&](const auto *... p) { return fun(p[i]...); }, pin);
+            for (std::size_t o = 0; o < n_out; ++o) po[o][i] = v[o];
+          };
+
+          int i = 0;
+          for (const int n0 = aligned ? std::min(peel(po[0]), n) : 0; i < n0; ++i)
+            scalar(i);
+          for (; i + w <= n; i += w)
+          {
+            const auto v = std::apply([&](const auto *... p) { return fun(load<real_t>(p + i)...); }, pin);
+            for (std::size_t o = 0; o < n_out; ++o)
+            {
+              if (aligned) store_aligned<real_t>(vec_t<real_t>(v[o]), po[o] + i);
+              else store<real_t>(vec_t<real_t>(v[o]), po[o] + i);
+            }
+          }
+          for (; i < n; ++i)
+            scalar(i);
+        }
+      }
+
+      // out = fun(in...) for arrays (views) of the same shape, element by element in rows along the dimension
+      // contiguous in memory (the same for all the arrays of a solver, see e.g. arr3D_storage) and the rows in
+      // the storage order of out, with fun called with vec_t<real_t> arguments for whole vectors (stored at
+      // aligned addresses in out, the inputs being usually offset by single elements) and with real_t ones
+      // for the rest of each row
+      template <class real_t, int n_dims, class fun_t, class... in_t>
+      void assign(const blitz::Array<real_t, n_dims> &out, const fun_t &fun, const in_t &... in)
+      {
+        assign_n<real_t, n_dims, 1>({&out}, [&](const auto &... x) {
+          using x_t = std::common_type_t<std::decay_t<decltype(x)>...>;
+          return std::array<x_t, 1>{x_t(fun(x...))};
+        }, in...);
+      }
+
+      // the same for two arrays computed together, with fun returning a std::array of two values
+      template <class real_t, int n_dims, class fun_t, class... in_t>
+      void assign2(const blitz::Array<real_t, n_dims> &out_1, const blitz::Array<real_t, n_dims> &out_2, const fun_t &fun, const in_t &... in)
+      {
+        assign_n<real_t, n_dims, 2>({&out_1, &out_2}, fun, in...);
+      }
+    } // namespace simd
+  } // namespace formulae
+} // namespace libmpdataxx
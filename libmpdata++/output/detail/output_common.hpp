@@ -193,6 +193,8 @@ namespace libmpdataxx
         {
           assert(int(outstart) % int(outfreq) == 0);
           assert(int(outstart)==0 || this->var_dt==0);
+          if (p.time_block > 1 && (int(outfreq) % p.time_block != 0 || outwindow != 1))
+            throw std::runtime_error("libmpdata++: with time_block the output frequency has to be its multiple (and outwindow 1)");
 
           // default value for outvars
           if (this->outvars.size() == 0 && parent_t::n_eqns == 1)
@@ -124,27 +124,35 @@ namespace libmpdataxx
 #if defined(USE_MPI)
           if (this->mem->distmem.size() > 1)
           {
-            shape[0] = this->mem->grid_size[0].length();
-            cshape[0] = this->mem->grid_size[0].length();
-
-            shape_h[0] = 
-              this->mem->distmem.rank() == 0 || this->mem->distmem.rank() == this->mem->distmem.size()-1 ? 
-                this->mem->grid_size[0].length() + this->halo : 
-                this->mem->grid_size[0].length(); 
-
-
-            if (this->mem->distmem.rank() == this->mem->distmem.size() - 1)
-              cshape[0] += 1;
-
-            offst[0]       = this->mem->grid_size[0].first();
-            offst_h[0]     = this->mem->distmem.rank() == 0 ? 0 : this->mem->grid_size[0].first() + this->halo;
-            if (this->mem->distmem.rank() > 0)
-              offst_mem_h[0] = this->halo;
-
-            // chunk size has to be common to all processes !
-            // TODO: set to 1? Test performance...
-            chunk[0]   = ( (typename solver_t::real_t) (this->mem->distmem.grid_size[0])) / this->mem->distmem.size() + 0.5 ;
-            chunk_h[0] = 1;//chunk[0];
+            // hyperslab of this process in each dimension split among processes
+            for (int d = 0; d < parent_t::n_dims; ++d)
+            {
+              const int
+                coord = this->mem->distmem.cart_coords[d],
+                n_coords = this->mem->distmem.cart_dims[d];
+              if (n_coords == 1) continue;
+
+              shape[d] = this->mem->grid_size[d].length();
+              cshape[d] = this->mem->grid_size[d].length();
+
+              shape_h[d] = 
+                coord == 0 || coord == n_coords - 1 ? 
+                  this->mem->grid_size[d].length() + this->halo : 
+                  this->mem->grid_size[d].length(); 
+
+              if (coord == n_coords - 1)
+                cshape[d] += 1;
+
+              offst[d]       = this->mem->grid_size[d].first();
+              offst_h[d]     = coord == 0 ? 0 : this->mem->grid_size[d].first() + this->halo;
+              if (coord > 0)
+                offst_mem_h[d] = this->halo;
+
+              // chunk size has to be common to all processes !
+              // TODO: set to 1? Test performance...
+              chunk[d]   = ( (typename solver_t::real_t) (this->mem->distmem.grid_size[d])) / n_coords + 0.5 ;
+              chunk_h[d] = 1;//chunk[d];
+            }
           }
 #endif
 
@@ -498,7 +506,11 @@ namespace libmpdataxx
         );
 
 #if defined(USE_MPI)
-        if (this->mem->distmem.rank() == 0)
+        // written by the processes at the beginning of all but the last dimension
+        bool writer = true;
+        for (int d = 0; d < parent_t::n_dims - 1; ++d)
+          writer = writer && this->mem->distmem.cart_coords[d] == 0;
+        if (writer)
 #endif
         {
           auto space = aux.getSpace();
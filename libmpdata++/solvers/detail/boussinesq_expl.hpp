@@ -55,7 +55,7 @@ namespace libmpdataxx
         inline auto buoy_at_0(const ijk_t &ijk)
         {
           return return_helper<rng_t>(
-            this->g * (this->state(ix::tht)(ijk) - this->tht_e(ijk)) / this->Tht_ref
+            this->g * (this->cstate(ix::tht)(ijk) - this->tht_e(ijk)) / this->Tht_ref
           );
         }
 
@@ -64,7 +64,7 @@ namespace libmpdataxx
         {
           return return_helper<rng_t>(
             this->g * (
-                (  this->state(ix::tht)(ijk)
+                (  this->cstate(ix::tht)(ijk)
                  + real_t(0.5) * this->dt * this->hflux_frc(ijk) + real_t(0.5) * this->dt * this->tht_abs(ijk) * this->tht_e(ijk))
                 / (1 + real_t(0.5) * this->dt * this->tht_abs(ijk))
                 - this->tht_e(ijk)
@@ -87,7 +87,7 @@ namespace libmpdataxx
         ) {
           parent_t::update_rhs(rhs, dt, at);
 
-          const auto &tht = this->state(ix::tht);
+          const auto &tht = this->cstate(ix::tht);
           const auto &ijk = this->ijk;
 
           auto ix_w = this->vip_ixs[ct_params_t::n_dims - 1];
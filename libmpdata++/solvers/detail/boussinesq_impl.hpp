@@ -92,8 +92,8 @@ namespace libmpdataxx
 
           auto ix_w = this->vip_ixs[ct_params_t::n_dims - 1];
 
-          const auto &tht = this->state(ix::tht);
-          const auto &w = this->state(ix_w);
+          const auto &tht = this->cstate(ix::tht);
+          const auto &w = this->cstate(ix_w);
           const auto &ijk = this->ijk;
 
           switch (at)
@@ -113,10 +113,7 @@ namespace libmpdataxx
           if constexpr (static_cast<sgs_scheme_t>(ct_params_t::sgs_scheme) == smg)
             this->xchng_sclr(this->k_m, this->ijk, 1);
           else
-          {
-            this->xchng_sclr(this->k_m[0], this->ijk, 1);
-            this->xchng_sclr(this->k_m[1], this->ijk, 1);
-          }
+            this->xchng_sclr({&this->k_m[0], &this->k_m[1]}, this->ijk, 1);
 
           // havo to use modified ijkm due to shared-memory parallelisation, otherwise overlapping ranges
           // would lead to double multiplications
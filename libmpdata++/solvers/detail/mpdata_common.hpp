@@ -34,7 +34,7 @@ namespace libmpdataxx
 
         // member fields
         std::vector<GC_t*> tmp;
-        GC_t &flux, *flux_ptr;
+        GC_t flux, *flux_ptr; // flux is a view of one of the scratch sets (see scratch_set())
 
         // methods
         GC_t &GC_unco(int iter)
@@ -69,12 +69,127 @@ namespace libmpdataxx
           return n_iters > 2 ? 2 : 1;
         }
 
+        // temporal blocking (time_block > 1): advop() calls block_advop() advancing psi[e] by block_steps
+        // time steps in tiles of the subdomain, each extended by one cell per side for each of the iterations
+        // of the block (the extensions are computed redundantly by the neighbouring tiles) and computed
+        // in the private arrays below, small enough to stay in cache for the whole block;
+        // the halos, filled once per block, are used as neighbouring or periodic data (see concurr_common)
+        const int time_block_tile;
+        arrvec_t<typename parent_t::arr_t> blk_psi;
+        std::array<GC_t, 2> blk_tmp;
+        GC_t blk_flux;
+
+        // as GC_unco(), GC_corr() and GC() but for the private arrays of a tile
+        GC_t &blk_GC_unco(int iter)
+        {
+          return (iter == 1) ? this->mem->GC : blk_tmp[iter % 2];
+        }
+
+        GC_t &blk_GC_corr(int iter)
+        {
+          return blk_tmp[(iter + 1) % 2];
+        }
+
+        GC_t &blk_GC(int iter)
+        {
+          return (iter == 0) ? this->mem->GC : blk_GC_corr(iter);
+        }
+
+        // a single iteration in a tile: psi_new(ijk_) from psi valid in ijk_ extended by one cell per side
+        // (and from the private antidiffusive velocities of the previous iteration), dimension-specific
+        virtual void block_iter(
+          const int iter,
+          const typename parent_t::arr_t &psi,
+          typename parent_t::arr_t &psi_new,
+          const idx_t<parent_t::n_dims> &ijk_
+        ) = 0;
+
+        // resizes (if needed) and reindexes a private array so that it covers box (with global indices)
+        static void blk_fit(typename parent_t::arr_t &a, const idx_t<parent_t::n_dims> &box)
+        {
+          const blitz::TinyVector<int, parent_t::n_dims> shape(box.ubound() - box.lbound() + 1);
+          if (any(a.shape() != shape)) a.resize(shape);
+          a.reindexSelf(box.lbound());
+        }
+
+        // a private array with the storage order of the shared ones
+        static typename parent_t::arr_t *blk_arr()
+        {
+          const blitz::TinyVector<int, parent_t::n_dims> one(1);
+          if constexpr (parent_t::n_dims == 3) return new typename parent_t::arr_t(one, arr3D_storage);
+          else return new typename parent_t::arr_t(one);
+        }
+
+        void block_advop(const int e)
+        {
+          constexpr int n_dims = parent_t::n_dims;
+          using box_t = blitz::TinyVector<rng_t, n_dims>;
+
+          // tiles in all dimensions but z in 3D (full columns, contiguous in memory)
+          std::array<std::vector<rng_t>, n_dims> tiles;
+          std::size_t n_tiles = 1;
+          for (int d = 0; d < n_dims; ++d)
+          {
+            const rng_t &r = this->ijk[d];
+            const int w = (time_block_tile > 0 && d < std::min(n_dims, 2)) ? time_block_tile : r.length();
+            for (int f = r.first(); f <= r.last(); f += w)
+              tiles[d].push_back(rng_t(f, std::min(f + w - 1, r.last())));
+            n_tiles *= tiles[d].size();
+          }
+
+          const int depth = this->block_steps * n_iters;
+          const auto extended = [](const box_t &t, const int r) {
+            box_t ret;
+            for (int d = 0; d < n_dims; ++d) ret[d] = t[d]^r;
+            return ret;
+          };
+
+          for (std::size_t c = 0; c < n_tiles; ++c)
+          {
+            box_t tile;
+            for (int d = 0, rem = c; d < n_dims; ++d)
+            {
+              tile[d] = tiles[d][rem % tiles[d].size()];
+              rem /= tiles[d].size();
+            }
+
+            const box_t ext = extended(tile, depth);
+            for (auto &a : blk_psi) blk_fit(a, idx_t<n_dims>(ext));
+            for (int d = 0; d < n_dims; ++d)
+            {
+              box_t ext_h = ext;
+              ext_h[d] = ext[d]^h;
+              for (auto *av : {&blk_tmp[0], &blk_tmp[1], &blk_flux}) blk_fit((*av)[d], idx_t<n_dims>(ext_h));
+            }
+
+            int cur = 0;
+            blk_psi[cur](idx_t<n_dims>(ext)) = this->mem->psi[e][this->n[e]](idx_t<n_dims>(ext));
+            for (int r = depth - 1; r >= 0; --r, cur = 1 - cur)
+              block_iter((depth - 1 - r) % n_iters, blk_psi[cur], blk_psi[1 - cur], idx_t<n_dims>(extended(tile, r)));
+
+            this->mem->psi[e][this->n[e] + 1](idx_t<n_dims>(tile)) = blk_psi[cur](idx_t<n_dims>(tile));
+          }
+        }
+
+        // scratch sets are stored one after another in tmp[__FILE__]
+        void scratch_set(const int s) override
+        {
+          const int n0 = s * (n_tmp(n_iters) + 1);
+          for (int n = 0; n < n_tmp(n_iters); ++n)
+            tmp[n] = &this->mem->tmp[__FILE__][n0 + n];
+          for (int d = 0; d < parent_t::n_dims; ++d)
+            flux[d].reference(this->mem->tmp[__FILE__][n0 + n_tmp(n_iters)][d]);
+        }
+
         public:
 
         struct rt_params_t : parent_t::rt_params_t
         {
           int n_iters = 2;
           int upwind_filter_freq = 0;
+          int fused_tile = 0; // 3D: if > 0, corrective iterations computed in tiles of that many columns in x and y (see mpdata_osc_3d)
+          int time_block = 1;      // if > 1, advectees advanced by up to that many time steps at once, needs halo >= time_block * n_iters (see minhalo)
+          int time_block_tile = 0; // with time_block > 1: tiles of that many cells in x and y (full columns in 3D), 0 for whole subdomains
         };
 
         protected:
@@ -88,9 +203,30 @@ namespace libmpdataxx
           n_iters(p.n_iters),
           upwind_filter_freq(p.upwind_filter_freq),
           tmp(n_tmp(n_iters)),
-          flux(args.mem->tmp[__FILE__][n_tmp(p.n_iters)])
+          flux(args.mem->tmp[__FILE__][n_tmp(p.n_iters)]),
+          time_block_tile(p.time_block_tile)
         {
           assert(n_iters > 0); // TODO: throw!
+          if (p.fused_tile > 0 && parent_t::n_dims != 3)
+            throw std::runtime_error("libmpdata++: fused_tile is supported in 3D only");
+
+          if (p.time_block < 1 || p.time_block_tile < 0)
+            throw std::runtime_error("libmpdata++: bogus time_block or time_block_tile");
+          if (p.time_block > 1)
+          {
+            // options whose stencils do not reach beyond one cell per iteration and which need no halo filling within an iteration
+            if (ct_params_t::opts & ~(opts::abs | opts::iga | opts::nug | opts::pfc))
+              throw std::runtime_error("libmpdata++: time_block can be used only with the abs, iga, nug and pfc options");
+            if (p.time_block * n_iters > parent_t::halo)
+              throw std::runtime_error("libmpdata++: time_block * n_iters exceeds the halo (increase minhalo)");
+            if (ct_params_t::var_dt || p.upwind_filter_freq > 0 || p.fused_tile > 0)
+              throw std::runtime_error("libmpdata++: time_block cannot be used with var_dt, upwind_filter_freq or fused_tile");
+
+            this->time_block = p.time_block;
+            for (int s = 0; s < 2; ++s) blk_psi.push_back(blk_arr());
+            for (int d = 0; d < parent_t::n_dims; ++d)
+              for (auto *av : {&blk_tmp[0], &blk_tmp[1], &blk_flux}) av->push_back(blk_arr());
+          }
 
           for (int n = 0; n < n_tmp(n_iters); ++n)
             tmp[n] = &args.mem->tmp[__FILE__][n];
@@ -104,9 +240,12 @@ namespace libmpdataxx
           const int &n_iters
         ) {
           parent_t::alloc(mem, n_iters);
-          for (int n = 0; n < n_tmp(n_iters); ++n)
-            parent_t::alloc_tmp_vctr(mem, __FILE__);
-          parent_t::alloc_tmp_vctr(mem, __FILE__); // fluxes
+          for (int s = 0; s < mem->n_scratch; ++s)
+          {
+            for (int n = 0; n < n_tmp(n_iters); ++n)
+              parent_t::alloc_tmp_vctr(mem, __FILE__);
+            parent_t::alloc_tmp_vctr(mem, __FILE__); // fluxes
+          }
         }
       };
 
@@ -30,19 +30,8 @@ namespace libmpdataxx
 
         void fct_init(int e)
         {
-          const auto i1 = this->i^1, j1 = this->j^1; // not optimal - with multiple threads some indices are repeated among threads
-          const auto psi = this->mem->psi[e][this->n[e]];
-
-          this->psi_min(i1,j1) = min(min(min(min(
-                           psi(i1,j1+1),
-            psi(i1-1,j1)), psi(i1,j1  )), psi(i1+1,j1)),
-                           psi(i1,j1-1)
-          );
-          this->psi_max(i1,j1) = max(max(max(max(
-                           psi(i1,j1+1),
-            psi(i1-1,j1)), psi(i1,j1  )), psi(i1+1,j1)),
-                           psi(i1,j1-1)
-          );
+          const auto ijk1 = this->ijk_fct();
+          formulae::mpdata::psi_min_max(this->psi_min, this->psi_max, this->mem->psi[e][this->n[e]], ijk1[0], ijk1[1]);
         }
 
         void fct_adjust_antidiff(int e, int iter)
@@ -50,8 +39,9 @@ namespace libmpdataxx
           const auto psi = this->mem->psi[e][this->n[e]];
           auto &GC_corr = parent_t::GC_corr(iter);
           const auto &G = *this->mem->G;
-          const auto i1 = this->i^1, j1 = this->j^1;
-          const auto im1 = this->im^1, jm1 = this->jm^1;
+          const auto ijk1 = this->ijk_fct();
+          const auto &i1 = ijk1[0], &j1 = ijk1[1];
+          const auto im1 = this->rm_fct(0, this->im), jm1 = this->rm_fct(1, this->jm);
           const auto &im(this->im), &jm(this->jm); // calculating once for (i/j)-1/2 and (i/j)+1/2
 
           // fill halos of GC_corr -> mpdata works with halo=1, we need halo=2
@@ -68,22 +58,23 @@ namespace libmpdataxx
             this->flux[0](im1+h, j1) = formulae::donorcell::make_flux<ct_params_t::opts, 0>(psi, GC_corr[0], im1, j1);
             this->flux[1](i1, jm1+h) = formulae::donorcell::make_flux<ct_params_t::opts, 1>(psi, GC_corr[1], jm1, i1);
             this->flux_ptr = &this->flux;
+
+            // needed: each thread computes only the fluxes through the faces in im, jm, ... i.e. not through
+            // the left faces of its first cells unless at the domain edge; beta() of these cells reads the
+            // fluxes there, computed by the neighbouring threads as the right faces of their last cells
+            this->mem->barrier_xchng(this->rank);
           }
 
           const auto &flx = (*(this->flux_ptr));
 
           // calculating betas
-          formulae::mpdata::beta_up<ct_params_t::opts>(this->beta_up, psi, this->psi_max, flx, G, i1, j1);
-          formulae::mpdata::beta_dn<ct_params_t::opts>(this->beta_dn, psi, this->psi_min, flx, G, i1, j1);
+          formulae::mpdata::beta<ct_params_t::opts>(this->beta_up, this->beta_dn, psi, this->psi_min, this->psi_max, flx, G, i1, j1);
 
-          // should detect the need for ext=1 halo-filling above (TODO: double check)
-          assert(std::isfinite(sum(this->beta_up(i1, this->j))));
-          assert(std::isfinite(sum(this->beta_up(this->i, j1))));
-          assert(std::isfinite(sum(this->beta_dn(i1, this->j))));
-          assert(std::isfinite(sum(this->beta_dn(this->i, j1))));
+          assert(std::isfinite(sum(this->beta_up(ijk1))));
+          assert(std::isfinite(sum(this->beta_dn(ijk1))));
 
-          // assuring flx, psi_min and psi_max are not overwritten
-          this->beta_barrier(iter);
+          // betas of the neighbouring threads computed and flx not overwritten before all betas are
+          this->mem->barrier_xchng(this->rank);
 
           // calculating the monotonic corrective velocity
           formulae::mpdata::GC_mono<ct_params_t::opts, 0>(this->GC_mono, psi, this->beta_up, this->beta_dn, GC_corr, G, im, this->j);
@@ -30,28 +30,8 @@ namespace libmpdataxx
 
         void fct_init(int e)
         {
-          const auto i1 = this->i^1, j1 = this->j^1, k1 = this->k^1; // not optimal - with multiple threads some indices are repeated among threads
-          const auto psi = this->mem->psi[e][this->n[e]];
-
-          this->psi_min(i1,j1,k1) = min(min(min(min(min(min(
-                        psi(i1,  j1,  k1),
-                        psi(i1+1,j1,  k1)),
-                        psi(i1-1,j1,  k1)),
-                        psi(i1,  j1+1,k1)),
-                        psi(i1,  j1-1,k1)),
-                        psi(i1,  j1,  k1+1)),
-                        psi(i1,  j1,  k1-1)
-          );
-
-          this->psi_max(i1,j1,k1) = max(max(max(max(max(max(
-                        psi(i1,  j1,  k1),
-                        psi(i1+1,j1,  k1)),
-                        psi(i1-1,j1,  k1)),
-                        psi(i1,  j1+1,k1)),
-                        psi(i1,  j1-1,k1)),
-                        psi(i1,  j1,  k1+1)),
-                        psi(i1,  j1,  k1-1)
-          );
+          const auto ijk1 = this->ijk_fct();
+          formulae::mpdata::psi_min_max(this->psi_min, this->psi_max, this->mem->psi[e][this->n[e]], ijk1[0], ijk1[1], ijk1[2]);
         }
 
         void fct_adjust_antidiff(int e, int iter)
@@ -61,11 +41,10 @@ namespace libmpdataxx
           const auto &G = *this->mem->G;
           const auto &im(this->im), &jm(this->jm), &km(this->km); // calculating once for (i/j/k)-1/2 and (i/j/k)+1/2
 
-          // not optimal - with multiple threads some indices are repeated among threads
+          const auto ijk1 = this->ijk_fct();
           const auto
-            i = this->i, j = this->j, k = this->k,
-            i1 = i^1, j1 = j^1, k1 = k^1,
-            im1 = this->im^1, jm1 = this->jm^1, km1 = this->km^1;
+            &i1 = ijk1[0], &j1 = ijk1[1], &k1 = ijk1[2],
+            im1 = this->rm_fct(0, im), jm1 = this->rm_fct(1, jm), km1 = this->rm_fct(2, km);
 
           // fill halos -> mpdata works with halo=1, we need halo=2
           this->xchng_vctr_alng(GC_corr, true);
@@ -82,26 +61,23 @@ namespace libmpdataxx
             this->flux[1](i1,    jm1+h, k1   ) = formulae::donorcell::make_flux<ct_params_t::opts, 1>(psi, GC_corr[1], jm1, k1, i1);
             this->flux[2](i1,    j1,    km1+h) = formulae::donorcell::make_flux<ct_params_t::opts, 2>(psi, GC_corr[2], km1, i1, j1);
             this->flux_ptr = &this->flux;
-          }
 
+            // needed: each thread computes only the fluxes through the faces in im, jm, ... i.e. not through
+            // the left faces of its first cells unless at the domain edge; beta() of these cells reads the
+            // fluxes there, computed by the neighbouring threads as the right faces of their last cells
+            this->mem->barrier_xchng(this->rank);
+          }
 
           const auto &flx = (*(this->flux_ptr));
 
           // calculating betas
-          formulae::mpdata::beta_up<ct_params_t::opts>(this->beta_up, psi, this->psi_max, flx, G, i1, j1, k1);
-          formulae::mpdata::beta_dn<ct_params_t::opts>(this->beta_dn, psi, this->psi_min, flx, G, i1, j1, k1);
-
+          formulae::mpdata::beta<ct_params_t::opts>(this->beta_up, this->beta_dn, psi, this->psi_min, this->psi_max, flx, G, i1, j1, k1);
 
-          // should detect the need for ext=1 in hallo-filling above
-          assert(std::isfinite(sum(this->beta_up(i1, j, k))));
-          assert(std::isfinite(sum(this->beta_up(i, j1, k))));
-          assert(std::isfinite(sum(this->beta_up(i, j, k1))));
-          assert(std::isfinite(sum(this->beta_dn(i1, j, k))));
-          assert(std::isfinite(sum(this->beta_dn(i, j1, k))));
-          assert(std::isfinite(sum(this->beta_dn(i, j, k1))));
+          assert(std::isfinite(sum(this->beta_up(ijk1))));
+          assert(std::isfinite(sum(this->beta_dn(ijk1))));
 
-          // assuring flx, psi_min and psi_max are not overwritten
-          this->beta_barrier(iter);
+          // betas of the neighbouring threads computed and flx not overwritten before all betas are
+          this->mem->barrier_xchng(this->rank);
 
           // calculating the monotonic corrective velocity
           formulae::mpdata::GC_mono<ct_params_t::opts, 0>(this->GC_mono, psi, this->beta_up, this->beta_dn, GC_corr, G, im, this->j, this->k);
@@ -35,12 +35,42 @@ namespace libmpdataxx
           return parent_t::GC(iter);
         }
 
+        // the cells of the subdomain extended by one cell only at the edges of the domain (the halo cells
+        // there being needed by GC_mono() and filled by no one else): the bounds and betas of the cells next
+        // to the subdomain edges are computed once, by the threads they belong to, and read by the neighbouring
+        // ones after a synchronisation instead of being recomputed by all of them
+        idx_t<parent_t::n_dims> ijk_fct() const
+        {
+          blitz::TinyVector<rng_t, parent_t::n_dims> r;
+          for (int d = 0; d < parent_t::n_dims; ++d) r[d] = this->extend_range_at_edges(d, this->ijk[d], 1);
+          return idx_t<parent_t::n_dims>(r);
+        }
+
+        // as above for the faces of these cells computed by this thread, given its faces rm in dimension d
+        rng_t rm_fct(const int d, const rng_t &rm) const
+        {
+          return this->extend_range_at_edges(d, rm, 1);
+        }
+
         void beta_barrier(const int &iter)
         {
           if (!opts::isset(ct_params_t::opts, opts::iga)) // this->flux would be overwritten by donor-cell
             this->mem->barrier();
         }
 
+        // scratch sets are stored one after another in tmp[__FILE__]
+        void scratch_set(const int s) override
+        {
+          parent_t::scratch_set(s);
+          auto &tmp = this->mem->tmp[__FILE__];
+          psi_min.reference(tmp[3 * s + 0][0]);
+          psi_max.reference(tmp[3 * s + 0][1]);
+          for (int d = 0; d < parent_t::n_dims; ++d)
+            GC_mono[d].reference(tmp[3 * s + 1][d]);
+          beta_up.reference(tmp[3 * s + 2][0]);
+          beta_dn.reference(tmp[3 * s + 2][1]);
+        }
+
         public:
 
         // ctor
@@ -61,9 +91,12 @@ namespace libmpdataxx
           const int &n_iters
         ) {
           parent_t::alloc(mem, n_iters);
-          parent_t::alloc_tmp_sclr(mem, __FILE__, 2); // psi_min and psi_max
-          parent_t::alloc_tmp_vctr(mem, __FILE__);    // GC_mono
-          parent_t::alloc_tmp_sclr(mem, __FILE__, 2); // beta_up, beta_dn
+          for (int s = 0; s < mem->n_scratch; ++s)
+          {
+            parent_t::alloc_tmp_sclr(mem, __FILE__, 2); // psi_min and psi_max
+            parent_t::alloc_tmp_vctr(mem, __FILE__);    // GC_mono
+            parent_t::alloc_tmp_sclr(mem, __FILE__, 2); // beta_up, beta_dn
+          }
         }
       };
 
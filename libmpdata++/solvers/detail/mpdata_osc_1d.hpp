@@ -32,7 +32,7 @@ namespace libmpdataxx
 
         protected:
 
-        const rng_t im;
+        rng_t im;
 
         void hook_ante_loop(const typename parent_t::advance_arg_t nt)
         {
@@ -54,9 +54,51 @@ namespace libmpdataxx
           }
         }
 
+        void block_iter(
+          const int iter,
+          const typename parent_t::arr_t &psi,
+          typename parent_t::arr_t &psi_new,
+          const idx_t<1> &ijk_
+        ) override
+        {
+          const rng_t &i_(ijk_[0]);
+          const rng_t im_(i_.first() - 1, i_.last());
+
+          if (iter != 0)
+            formulae::mpdata::antidiff<ct_params_t::opts,
+                                       static_cast<sptl_intrp_t>(ct_params_t::sptl_intrp),
+                                       static_cast<tmprl_extrp_t>(ct_params_t::tmprl_extrp)>(
+              this->blk_GC_corr(iter)[0], psi, this->blk_GC_unco(iter),
+              this->mem->ndt_GC, this->mem->ndtt_GC, *this->mem->G, im_
+            );
+
+          auto *flx = &this->blk_GC(iter);
+          if (!opts::isset(ct_params_t::opts, opts::iga) || iter == 0)
+          {
+            formulae::donorcell::set_flux<ct_params_t::opts>(this->blk_flux[0], psi, (*flx)[0], im_);
+            flx = &this->blk_flux;
+          }
+
+          formulae::donorcell::donorcell_sum<ct_params_t::opts>(
+            this->mem->khn_tmp,
+            ijk_,
+            psi_new(ijk_),
+            psi(ijk_),
+            (*flx)[0](i_+h),
+            (*flx)[0](i_-h),
+            formulae::G<ct_params_t::opts>(*this->mem->G, i_)
+          );
+        }
+
         // method invoked by the solver
         void advop(int e)
         {
+          if (this->time_block > 1)
+          {
+            this->block_advop(e);
+            return;
+          }
+
           this->fct_init(e); // e.g. store psi_min, psi_max in FCT
 
           for (int iter = 0; iter < this->n_iters; ++iter)
@@ -94,7 +136,8 @@ namespace libmpdataxx
             // calculation of fluxes
             if (!opts::isset(ct_params_t::opts, opts::iga) || iter == 0)
             {
-              this->flux[0](im+h) = formulae::donorcell::make_flux<ct_params_t::opts>(
+              formulae::donorcell::set_flux<ct_params_t::opts>(
+                this->flux[0],
                 this->mem->psi[e][this->n[e]],
                 this->GC(iter)[0],
                 im
@@ -167,6 +210,12 @@ namespace libmpdataxx
 
         public:
 
+        void set_subdomain(const idx_t<parent_t::n_dims> &ijk_new) override
+        {
+          parent_t::set_subdomain(ijk_new);
+          im = rng_t(this->ijk[0].first() - 1, this->ijk[0].last());
+        }
+
         // ctor
         mpdata_osc(
           typename parent_t::ctor_args_t args,
@@ -35,7 +35,7 @@ namespace libmpdataxx
         protected:
 
         // member fields
-        const rng_t im, jm;
+        rng_t im, jm;
 
         void hook_ante_loop(const typename parent_t::advance_arg_t nt)
         {
@@ -66,9 +66,63 @@ namespace libmpdataxx
           }
         }
 
+        void block_iter(
+          const int iter,
+          const typename parent_t::arr_t &psi,
+          typename parent_t::arr_t &psi_new,
+          const idx_t<2> &ijk_
+        ) override
+        {
+          const rng_t &i_(ijk_[0]), &j_(ijk_[1]);
+          const rng_t im_(i_.first() - 1, i_.last()), jm_(j_.first() - 1, j_.last());
+          using namespace formulae::donorcell;
+
+          if (iter != 0)
+          {
+            formulae::mpdata::antidiff<ct_params_t::opts, 0,
+                                       static_cast<sptl_intrp_t>(ct_params_t::sptl_intrp),
+                                       static_cast<tmprl_extrp_t>(ct_params_t::tmprl_extrp)>(
+              this->blk_GC_corr(iter)[0], psi, psi, this->blk_GC_unco(iter),
+              this->mem->ndt_GC, this->mem->ndtt_GC, *this->mem->G, im_, j_
+            );
+            formulae::mpdata::antidiff<ct_params_t::opts, 1,
+                                       static_cast<sptl_intrp_t>(ct_params_t::sptl_intrp),
+                                       static_cast<tmprl_extrp_t>(ct_params_t::tmprl_extrp)>(
+              this->blk_GC_corr(iter)[1], psi, psi, this->blk_GC_unco(iter),
+              this->mem->ndt_GC, this->mem->ndtt_GC, *this->mem->G, jm_, i_
+            );
+          }
+
+          auto *flx = &this->blk_GC(iter);
+          if (!opts::isset(ct_params_t::opts, opts::iga) || iter == 0)
+          {
+            set_flux<ct_params_t::opts, 0>(this->blk_flux[0], psi, (*flx)[0], im_, j_);
+            set_flux<ct_params_t::opts, 1>(this->blk_flux[1], psi, (*flx)[1], jm_, i_);
+            flx = &this->blk_flux;
+          }
+
+          donorcell_sum<ct_params_t::opts>(
+            this->mem->khn_tmp,
+            ijk_,
+            psi_new(ijk_),
+            psi(ijk_),
+            (*flx)[0](i_+h, j_  ),
+            (*flx)[0](i_-h, j_  ),
+            (*flx)[1](i_,   j_+h),
+            (*flx)[1](i_,   j_-h),
+            formulae::G<ct_params_t::opts, 0>(*this->mem->G, i_, j_)
+          );
+        }
+
         // method invoked by the solver
         void advop(int e)
         {
+          if (this->time_block > 1)
+          {
+            this->block_advop(e);
+            return;
+          }
+
           this->fct_init(e);
 
           for (int iter = 0; iter < this->n_iters; ++iter)
@@ -133,12 +187,14 @@ namespace libmpdataxx
             // calculation of fluxes
             if (!opts::isset(ct_params_t::opts, opts::iga) || iter == 0)
             {
-              this->flux[0](im+h, this->j) = formulae::donorcell::make_flux<ct_params_t::opts, 0>(
+              formulae::donorcell::set_flux<ct_params_t::opts, 0>(
+                this->flux[0],
                 this->mem->psi[e][this->n[e]],
                 this->GC(iter)[0],
                 im, this->j
               );
-              this->flux[1](this->i, jm+h) = formulae::donorcell::make_flux<ct_params_t::opts, 1>(
+              formulae::donorcell::set_flux<ct_params_t::opts, 1>(
+                this->flux[1],
                 this->mem->psi[e][this->n[e]],
                 this->GC(iter)[1],
                 jm, this->i
@@ -224,14 +280,21 @@ namespace libmpdataxx
 
         public:
 
+        void set_subdomain(const idx_t<parent_t::n_dims> &ijk_new) override
+        {
+          parent_t::set_subdomain(ijk_new);
+          im = rng_t(this->ijk[0].first() == this->mem->grid_size[0].first() ? this->ijk[0].first() - 1 : this->ijk[0].first(), this->ijk[0].last());
+          jm = rng_t(this->ijk[1].first() == this->mem->grid_size[1].first() ? this->ijk[1].first() - 1 : this->ijk[1].first(), this->ijk[1].last());
+        }
+
         // ctor
         mpdata_osc(
           typename parent_t::ctor_args_t args,
           const typename parent_t::rt_params_t &p
         ) :
           parent_t(args, p),
-          im(this->rank == 0 ? args.i.first() - 1 : args.i.first(), args.i.last()),
-          jm(args.j.first() - 1, args.j.last())
+          im(args.i.first() == this->mem->grid_size[0].first() ? args.i.first() - 1 : args.i.first(), args.i.last()),
+          jm(args.j.first() == this->mem->grid_size[1].first() ? args.j.first() - 1 : args.j.first(), args.j.last())
         { }
       };
     } // namespace detail
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 
 #include <libmpdata++/formulae/mpdata/formulae_mpdata_common.hpp>  //TODO tmp
@@ -35,7 +36,8 @@ namespace libmpdataxx
         protected:
 
         // member fields
-        const rng_t im, jm, km;
+        rng_t im, jm, km;
+        const int fused_tile;
 
         void hook_ante_loop(const typename parent_t::advance_arg_t nt)
         {
@@ -69,63 +71,248 @@ namespace libmpdataxx
           }
         }
 
+        // antidiffusive velocities of the iter-th iteration: the x component at faces im_+h,
+        // the y and z components in columns i_ (subsets of im and i when overlapping the x halo exchange
+        // or when computing in tiles, when also the y faces jm_+h and columns j_ are subsets of jm and j)
+        void antidiff(const int e, const int iter, const rng_t &im_, const rng_t &i_, const rng_t &jm_, const rng_t &j_)
+        {
+          formulae::mpdata::antidiff<ct_params_t::opts, 0,
+                                     static_cast<sptl_intrp_t>(ct_params_t::sptl_intrp),
+                                     static_cast<tmprl_extrp_t>(ct_params_t::tmprl_extrp)>(
+            this->GC_corr(iter)[0],
+            this->mem->psi[e][this->n[e]],
+            this->mem->psi[e][this->n[e]-1],
+            this->GC_unco(iter),
+            this->mem->ndt_GC,
+            this->mem->ndtt_GC,
+            *this->mem->G,
+            im_,
+            j_,
+            this->k
+          );
+
+          formulae::mpdata::antidiff<ct_params_t::opts, 1,
+                                     static_cast<sptl_intrp_t>(ct_params_t::sptl_intrp),
+                                     static_cast<tmprl_extrp_t>(ct_params_t::tmprl_extrp)>(
+            this->GC_corr(iter)[1],
+            this->mem->psi[e][this->n[e]],
+            this->mem->psi[e][this->n[e]-1],
+            this->GC_unco(iter),
+            this->mem->ndt_GC,
+            this->mem->ndtt_GC,
+            *this->mem->G,
+            jm_,
+            this->k,
+            i_
+          );
+
+          formulae::mpdata::antidiff<ct_params_t::opts, 2,
+                                     static_cast<sptl_intrp_t>(ct_params_t::sptl_intrp),
+                                     static_cast<tmprl_extrp_t>(ct_params_t::tmprl_extrp)>(
+            this->GC_corr(iter)[2],
+            this->mem->psi[e][this->n[e]],
+            this->mem->psi[e][this->n[e]-1],
+            this->GC_unco(iter),
+            this->mem->ndt_GC,
+            this->mem->ndtt_GC,
+            *this->mem->G,
+            this->km,
+            i_,
+            j_
+          );
+        }
+
+        void antidiff(const int e, const int iter, const rng_t &im_, const rng_t &i_)
+        {
+          antidiff(e, iter, im_, i_, this->jm, this->j);
+        }
+
+        // the donor-cell update of the cells ii, jj, kk (if any)
+        void donorcell_part(const int e, const rng_t &ii, const rng_t &jj, const rng_t &kk)
+        {
+          if (ii.first() > ii.last() || jj.first() > jj.last() || kk.first() > kk.last()) return;
+
+          const auto &psi(this->mem->psi[e]);
+          const auto &n(this->n[e]);
+          const auto &flx(*this->flux_ptr);
+          using namespace formulae::donorcell;
+
+          donorcell_sum<ct_params_t::opts>(
+            this->mem->khn_tmp,
+            idx_t<3>({ii, jj, kk}),
+            psi[n+1](ii, jj, kk),
+            psi[n  ](ii, jj, kk),
+            flx[0](ii+h, jj,    kk   ),
+            flx[0](ii-h, jj,    kk   ),
+            flx[1](ii,   jj+h,  kk   ),
+            flx[1](ii,   jj-h,  kk   ),
+            flx[2](ii,   jj,    kk+h),
+            flx[2](ii,   jj,    kk-h),
+            formulae::G<ct_params_t::opts, 0>(*this->mem->G, ii, jj, kk)
+          );
+        }
+
+        // a corrective iteration computed in tiles of fused_tile x fused_tile columns (contiguous in memory
+        // with the default storage order): the antidiffusive velocities, the fluxes and the donor-cell update
+        // done tile after tile while they are in cache, instead of each over the whole subdomain; the update
+        // of the cells next to the subdomain edges, which need fluxes computed by other threads or set by
+        // the bconds, is done after the flux exchange
+        void fused_iter(const int e, const int iter)
+        {
+          const auto &i(this->i), &j(this->j), &k(this->k);
+          const auto &psi(this->mem->psi[e]);
+          const auto &n(this->n[e]);
+          auto &GC(this->GC_corr(iter));
+          auto &flx(this->flux);
+          using namespace formulae::donorcell;
+
+          this->flux_ptr = &this->flux;
+
+          const auto isct = [](const rng_t &a, const rng_t &b) {
+            return rng_t(std::max(a.first(), b.first()), std::min(a.last(), b.last()));
+          };
+          const rng_t
+            ic(i.first() + 1, i.last() - 1),
+            jc(j.first() + 1, j.last() - 1),
+            kc(k.first() + 1, k.last() - 1);
+
+          for (int i0 = i.first(); i0 <= i.last(); i0 += fused_tile)
+          {
+            // the lower faces of a tile are computed with the preceding tile, except for the first one
+            const rng_t ti(i0, std::min(i0 + fused_tile - 1, i.last())), tim(i0 == i.first() ? im.first() : i0, ti.last());
+            for (int j0 = j.first(); j0 <= j.last(); j0 += fused_tile)
+            {
+              const rng_t tj(j0, std::min(j0 + fused_tile - 1, j.last())), tjm(j0 == j.first() ? jm.first() : j0, tj.last());
+
+              antidiff(e, iter, tim, ti, tjm, tj);
+
+              set_flux<ct_params_t::opts, 0>(flx[0], psi[n], GC[0], tim, tj, k);
+              set_flux<ct_params_t::opts, 1>(flx[1], psi[n], GC[1], tjm, k, ti);
+              set_flux<ct_params_t::opts, 2>(flx[2], psi[n], GC[2], km, ti, tj);
+
+              donorcell_part(e, isct(ti, ic), isct(tj, jc), kc);
+            }
+          }
+
+          // as in advop(), for the next iteration (without dfl, which needs the along exchange
+          // before the fluxes and is hence rejected in the ctor)
+          if (iter != (this->n_iters - 1)) this->xchng_vctr_nrml(GC, this->ijk);
+
+          this->xchng_flux(flx);
+
+          // the cells next to the subdomain edges
+          donorcell_part(e, rng_t(i.first(), i.first()), j, k);
+          if (i.last() != i.first()) donorcell_part(e, rng_t(i.last(), i.last()), j, k);
+          donorcell_part(e, ic, rng_t(j.first(), j.first()), k);
+          if (j.last() != j.first()) donorcell_part(e, ic, rng_t(j.last(), j.last()), k);
+          donorcell_part(e, ic, jc, rng_t(k.first(), k.first()));
+          if (k.last() != k.first()) donorcell_part(e, ic, jc, rng_t(k.last(), k.last()));
+
+          // sanity check for output
+          assert(std::isfinite(sum(psi[n+1](this->ijk))));
+        }
+
+        void block_iter(
+          const int iter,
+          const typename parent_t::arr_t &psi,
+          typename parent_t::arr_t &psi_new,
+          const idx_t<3> &ijk_
+        ) override
+        {
+          const rng_t &i_(ijk_[0]), &j_(ijk_[1]), &k_(ijk_[2]);
+          const rng_t im_(i_.first() - 1, i_.last()), jm_(j_.first() - 1, j_.last()), km_(k_.first() - 1, k_.last());
+          using namespace formulae::donorcell;
+
+          if (iter != 0)
+          {
+            formulae::mpdata::antidiff<ct_params_t::opts, 0,
+                                       static_cast<sptl_intrp_t>(ct_params_t::sptl_intrp),
+                                       static_cast<tmprl_extrp_t>(ct_params_t::tmprl_extrp)>(
+              this->blk_GC_corr(iter)[0], psi, psi, this->blk_GC_unco(iter),
+              this->mem->ndt_GC, this->mem->ndtt_GC, *this->mem->G, im_, j_, k_
+            );
+            formulae::mpdata::antidiff<ct_params_t::opts, 1,
+                                       static_cast<sptl_intrp_t>(ct_params_t::sptl_intrp),
+                                       static_cast<tmprl_extrp_t>(ct_params_t::tmprl_extrp)>(
+              this->blk_GC_corr(iter)[1], psi, psi, this->blk_GC_unco(iter),
+              this->mem->ndt_GC, this->mem->ndtt_GC, *this->mem->G, jm_, k_, i_
+            );
+            formulae::mpdata::antidiff<ct_params_t::opts, 2,
+                                       static_cast<sptl_intrp_t>(ct_params_t::sptl_intrp),
+                                       static_cast<tmprl_extrp_t>(ct_params_t::tmprl_extrp)>(
+              this->blk_GC_corr(iter)[2], psi, psi, this->blk_GC_unco(iter),
+              this->mem->ndt_GC, this->mem->ndtt_GC, *this->mem->G, km_, i_, j_
+            );
+          }
+
+          auto *flx = &this->blk_GC(iter);
+          if (!opts::isset(ct_params_t::opts, opts::iga) || iter == 0)
+          {
+            set_flux<ct_params_t::opts, 0>(this->blk_flux[0], psi, (*flx)[0], im_, j_, k_);
+            set_flux<ct_params_t::opts, 1>(this->blk_flux[1], psi, (*flx)[1], jm_, k_, i_);
+            set_flux<ct_params_t::opts, 2>(this->blk_flux[2], psi, (*flx)[2], km_, i_, j_);
+            flx = &this->blk_flux;
+          }
+
+          donorcell_sum<ct_params_t::opts>(
+            this->mem->khn_tmp,
+            ijk_,
+            psi_new(ijk_),
+            psi(ijk_),
+            (*flx)[0](i_+h, j_,   k_  ),
+            (*flx)[0](i_-h, j_,   k_  ),
+            (*flx)[1](i_,   j_+h, k_  ),
+            (*flx)[1](i_,   j_-h, k_  ),
+            (*flx)[2](i_,   j_,   k_+h),
+            (*flx)[2](i_,   j_,   k_-h),
+            formulae::G<ct_params_t::opts, 0>(*this->mem->G, i_, j_, k_)
+          );
+        }
+
         // method invoked by the solver
         void advop(int e)
         {
-          this->fct_init(e);
+          if (this->time_block > 1)
+          {
+            if (this->xchng_begin(e)) this->xchng_end(e);
+            this->block_advop(e);
+            return;
+          }
+
+          // with xchng_overlap the psi halos are exchanged here (see solver_3d::xchng_begin()),
+          // the computations not reaching the x halos being done while the exchange is in progress
+          const bool overlap = this->mem->xchng_overlap;
+
+          if (!overlap) this->fct_init(e);
 
           for (int iter = 0; iter < this->n_iters; ++iter)
           {
+            if (iter != 0 && fused_tile > 0)
+            {
+              this->cycle(e);
+              if (this->xchng_begin(e)) this->xchng_end(e);
+              fused_iter(e, iter);
+              continue;
+            }
+
             if (iter != 0)
             {
               this->cycle(e);
-              this->xchng(e);
 
               // calculating the antidiffusive C
-              formulae::mpdata::antidiff<ct_params_t::opts, 0,
-                                         static_cast<sptl_intrp_t>(ct_params_t::sptl_intrp),
-                                         static_cast<tmprl_extrp_t>(ct_params_t::tmprl_extrp)>(
-                this->GC_corr(iter)[0],
-                this->mem->psi[e][this->n[e]],
-                this->mem->psi[e][this->n[e]-1],
-                this->GC_unco(iter),
-                this->mem->ndt_GC,
-                this->mem->ndtt_GC,
-                *this->mem->G,
-                this->im,
-                this->j,
-                this->k
-              );
-
-              formulae::mpdata::antidiff<ct_params_t::opts, 1,
-                                         static_cast<sptl_intrp_t>(ct_params_t::sptl_intrp),
-                                         static_cast<tmprl_extrp_t>(ct_params_t::tmprl_extrp)>(
-                this->GC_corr(iter)[1],
-                this->mem->psi[e][this->n[e]],
-                this->mem->psi[e][this->n[e]-1],
-                this->GC_unco(iter),
-                this->mem->ndt_GC,
-                this->mem->ndtt_GC,
-                *this->mem->G,
-                this->jm,
-                this->k,
-                this->i
-              );
-
-              formulae::mpdata::antidiff<ct_params_t::opts, 2,
-                                         static_cast<sptl_intrp_t>(ct_params_t::sptl_intrp),
-                                         static_cast<tmprl_extrp_t>(ct_params_t::tmprl_extrp)>(
-                this->GC_corr(iter)[2],
-                this->mem->psi[e][this->n[e]],
-                this->mem->psi[e][this->n[e]-1],
-                this->GC_unco(iter),
-                this->mem->ndt_GC,
-                this->mem->ndtt_GC,
-                *this->mem->G,
-                this->km,
-                this->i,
-                this->j
-              );
+              if (!this->xchng_begin(e))
+              {
+                antidiff(e, iter, this->im, this->i);
+              }
+              else
+              {
+                // the stencils reach w points in x, away from the x halos first
+                const int w = formulae::mpdata::halo(ct_params_t::opts), i0 = this->i.first(), i1 = this->i.last();
+                antidiff(e, iter, rng_t(i0 + w - 1, i1 - w), rng_t(i0 + w, i1 - w));
+                this->xchng_end(e);
+                antidiff(e, iter, rng_t(this->im.first(), i0 + w - 2), rng_t(i0, i0 + w - 1));
+                antidiff(e, iter, rng_t(i1 - w + 1, i1), rng_t(i1 - w + 1, i1));
+              }
 
               if (opts::isset(ct_params_t::opts, opts::div_3rd_dt))
                 this->mem->barrier();
@@ -156,9 +343,24 @@ namespace libmpdataxx
             // calculation of fluxes
             if (!opts::isset(ct_params_t::opts, opts::iga) || iter == 0)
             {
-              this->flux[0](im+h, j, k) = make_flux<ct_params_t::opts, 0>(psi[n], GC[0], im, j, k);
-              this->flux[1](i, jm+h, k) = make_flux<ct_params_t::opts, 1>(psi[n], GC[1], jm, k, i);
-              this->flux[2](i, j, km+h) = make_flux<ct_params_t::opts, 2>(psi[n], GC[2], km, i, j);
+              // with the x halos being exchanged, the x fluxes at the subdomain x edges are calculated last
+              const bool split = iter == 0 && overlap && this->xchng_begin(e);
+              const rng_t im_ = split ? rng_t(i.first(), i.last() - 1) : im;
+
+              set_flux<ct_params_t::opts, 0>(this->flux[0], psi[n], GC[0], im_, j, k);
+              set_flux<ct_params_t::opts, 1>(this->flux[1], psi[n], GC[1], jm, k, i);
+              set_flux<ct_params_t::opts, 2>(this->flux[2], psi[n], GC[2], km, i, j);
+
+              if (split)
+              {
+                this->xchng_end(e);
+                const rng_t iml(im.first(), i.first() - 1), imr(i.last(), i.last());
+                if (iml.first() <= iml.last())
+                  set_flux<ct_params_t::opts, 0>(this->flux[0], psi[n], GC[0], iml, j, k);
+                set_flux<ct_params_t::opts, 0>(this->flux[0], psi[n], GC[0], imr, j, k);
+              }
+
+              if (iter == 0 && overlap) this->fct_init(e);
               this->flux_ptr = &this->flux; // TODO: if !iga this is needed only once per simulation, TODO: move to common
             }
             else
@@ -247,16 +449,33 @@ namespace libmpdataxx
 
         public:
 
+        void set_subdomain(const idx_t<parent_t::n_dims> &ijk_new) override
+        {
+          parent_t::set_subdomain(ijk_new);
+          im = rng_t(this->ijk[0].first() == this->mem->grid_size[0].first() ? this->ijk[0].first() - 1 : this->ijk[0].first(), this->ijk[0].last());
+          jm = rng_t(this->ijk[1].first() == this->mem->grid_size[1].first() ? this->ijk[1].first() - 1 : this->ijk[1].first(), this->ijk[1].last());
+          km = rng_t(this->ijk[2].first() - 1, this->ijk[2].last());
+        }
+
         // ctor
         mpdata_osc(
           typename parent_t::ctor_args_t args,
           const typename parent_t::rt_params_t &p
         ) :
           parent_t(args, p),
-          im(args.i.first() - 1, args.i.last()),
-          jm(this->rank == 0 ? args.j.first() - 1 : args.j.first(), args.j.last()),
-          km(args.k.first() - 1, args.k.last())
-        { }
+          im(args.i.first() == this->mem->grid_size[0].first() ? args.i.first() - 1 : args.i.first(), args.i.last()),
+          jm(args.j.first() == this->mem->grid_size[1].first() ? args.j.first() - 1 : args.j.first(), args.j.last()),
+          km(args.k.first() - 1, args.k.last()),
+          fused_tile(p.fused_tile)
+        {
+          if (fused_tile > 0 && (
+            opts::isset(ct_params_t::opts, opts::fct) ||
+            opts::isset(ct_params_t::opts, opts::iga) ||
+            opts::isset(ct_params_t::opts, opts::dfl) ||
+            opts::isset(ct_params_t::opts, opts::div_3rd_dt)
+          ))
+            throw std::runtime_error("libmpdata++: fused_tile cannot be used with the fct, iga, dfl or div_3rd_dt options");
+        }
       };
     } // namespace detail
   } // namespace solvers
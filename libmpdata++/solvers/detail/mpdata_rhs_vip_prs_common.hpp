@@ -47,6 +47,15 @@ namespace libmpdataxx
           return this->mem->sum(this->rank, arr1, arr2, ijk, ct_params_t::prs_khn);
         }
 
+        // several prs_sum()-s and min/max-es over this->ijk at the cost of one (see sharedmem::reduce())
+        using reduction_t = typename parent_t::mem_t::reduction_t;
+
+        std::vector<real_t> prs_reduce(const std::vector<reduction_t> &batch)
+        {
+          const std::vector<double> res = this->mem->reduce(this->rank, batch, this->ijk, ct_params_t::prs_khn);
+          return std::vector<real_t>(res.begin(), res.end());
+        }
+
         auto lap(
           arr_t &arr,
           const ijk_t &ijk,
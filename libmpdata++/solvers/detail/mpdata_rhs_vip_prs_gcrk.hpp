@@ -33,6 +33,7 @@ namespace libmpdataxx
 
         real_t beta;
         std::vector<real_t> alpha, tmp_den;
+        std::vector<typename parent_t::reduction_t> batch;
         typename parent_t::arr_t lap_err;
         arrvec_t<typename parent_t::arr_t> p_err, lap_p_err;
 
@@ -46,26 +47,35 @@ namespace libmpdataxx
         {
           for (int v = 0; v < k_iters; ++v)
           {
-            tmp_den[v] = this->prs_sum(lap_p_err[v], lap_p_err[v], this->ijk);
-            if (tmp_den[v] != 0) beta = - this->prs_sum(this->err, lap_p_err[v], this->ijk) / tmp_den[v];
+            const auto sums = this->prs_reduce({
+              parent_t::mem_t::sum_of(lap_p_err[v], lap_p_err[v]),
+              parent_t::mem_t::sum_of(this->err, lap_p_err[v])
+            });
+            tmp_den[v] = sums[0];
+            if (tmp_den[v] != 0) beta = - sums[1] / tmp_den[v];
             this->Phi(this->ijk) += beta * p_err[v](this->ijk);
             this->err(this->ijk) += beta * lap_p_err[v](this->ijk);
 
-            real_t error = std::max(
-              std::abs(this->mem->max(this->rank, this->err(this->ijk))),
-              std::abs(this->mem->min(this->rank, this->err(this->ijk)))
-            );
-
-            if (error <= this->err_tol) this->converged = true;
-
             lap_err(this->ijk) = this->lap(this->err, this->ijk, this->dijk, false, simple);
 
+            // alpha-s and the error norm in one go (convergence is checked after the loop body)
+            batch.clear();
+            for (int l = 0; l <= v; ++l)
+              batch.push_back(parent_t::mem_t::sum_of(lap_err, lap_p_err[l]));
+            batch.push_back(parent_t::mem_t::max_of(this->err));
+            batch.push_back(parent_t::mem_t::min_of(this->err));
+            const auto res = this->prs_reduce(batch);
+
             for (int l = 0; l <= v; ++l)
             {
               if (tmp_den[l] != 0)
-                alpha[l] = - this->prs_sum(lap_err, lap_p_err[l], this->ijk) / tmp_den[l];
+                alpha[l] = - res[l] / tmp_den[l];
             }
 
+            real_t error = std::max(std::abs(res[v + 1]), std::abs(res[v + 2]));
+
+            if (error <= this->err_tol) this->converged = true;
+
             if (v < (k_iters - 1))
             {
               p_err[v + 1](this->ijk) = this->err(this->ijk);
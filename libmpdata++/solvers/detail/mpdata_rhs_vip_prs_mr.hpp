@@ -41,16 +41,21 @@ namespace libmpdataxx
         {
           this->lap_err(this->ijk) = this->lap(this->err, this->ijk, this->dijk, false, simple);
 
-          tmp_den = this->prs_sum(this->lap_err, this->lap_err, this->ijk);
-          if (tmp_den != 0) beta = - this->prs_sum(this->err, this->lap_err, this->ijk) / tmp_den;
+          const auto sums = this->prs_reduce({
+            parent_t::mem_t::sum_of(this->lap_err, this->lap_err),
+            parent_t::mem_t::sum_of(this->err, this->lap_err)
+          });
+          tmp_den = sums[0];
+          if (tmp_den != 0) beta = - sums[1] / tmp_den;
 
           this->Phi(this->ijk) += beta * this->err(this->ijk);
           this->err(this->ijk) += beta * this->lap_err(this->ijk);
 
-          real_t error = std::max(
-            std::abs(this->mem->max(this->rank, this->err(this->ijk))),
-            std::abs(this->mem->min(this->rank, this->err(this->ijk)))
-          );
+          const auto xtms = this->prs_reduce({
+            parent_t::mem_t::max_of(this->err),
+            parent_t::mem_t::min_of(this->err)
+          });
+          real_t error = std::max(std::abs(xtms[0]), std::abs(xtms[1]));
 
           if (error <= this->err_tol) this->converged = true;
         }
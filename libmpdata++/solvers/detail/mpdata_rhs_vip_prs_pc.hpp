@@ -63,24 +63,32 @@ namespace libmpdataxx
 
         void pressure_solver_loop_body(bool simple) final
         {
-          tmp_den = this->prs_sum(lap_p_err, lap_p_err, this->ijk);
-          if (tmp_den != 0) beta = -this->prs_sum(this->err, lap_p_err, this->ijk) / tmp_den;
+          const auto sums = this->prs_reduce({
+            parent_t::mem_t::sum_of(lap_p_err, lap_p_err),
+            parent_t::mem_t::sum_of(this->err, lap_p_err)
+          });
+          tmp_den = sums[0];
+          if (tmp_den != 0) beta = -sums[1] / tmp_den;
 
           this->Phi(this->ijk) += beta * p_err(this->ijk);
           this->err(this->ijk) += beta * lap_p_err(this->ijk);
 
-          real_t error = std::max(
-            std::abs(this->mem->max(this->rank, this->err(this->ijk))),
-            std::abs(this->mem->min(this->rank, this->err(this->ijk)))
-          );
-
-          if (error <= this->err_tol) this->converged = true;
-
           precond();
 
           this->lap_q_err(this->ijk) = this->lap(this->q_err, this->ijk, this->dijk, false, simple);
 
-          if (tmp_den != 0) alpha = -this->prs_sum(lap_q_err, lap_p_err, this->ijk) / tmp_den;
+          // alpha and the error norm in one go (convergence is checked after the loop body)
+          const auto res = this->prs_reduce({
+            parent_t::mem_t::sum_of(lap_q_err, lap_p_err),
+            parent_t::mem_t::max_of(this->err),
+            parent_t::mem_t::min_of(this->err)
+          });
+
+          if (tmp_den != 0) alpha = -res[0] / tmp_den;
+
+          real_t error = std::max(std::abs(res[1]), std::abs(res[2]));
+
+          if (error <= this->err_tol) this->converged = true;
 
           p_err(this->ijk) *= alpha;
           p_err(this->ijk) += q_err(this->ijk);
@@ -176,6 +176,34 @@ namespace libmpdataxx
           }
         }
 
+        private:
+
+        // per-thread ranges derived from ijk
+        void set_sgs_ranges()
+        {
+          for (int d = 0; d < ct_params_t::n_dims; ++d)
+          {
+            ijkm.lbound()(d) = this->ijk[d].first() - 1;
+            ijkm.ubound()(d) = this->ijk[d].last();
+
+            ijk_vec[d] = rng_t(this->ijk[d].first(),     this->ijk[d].last());
+          }
+
+          // extend/separate only at the edges of the domain, not between sub-domains of different threads
+          if (this->ijk[0].first() == this->mem->grid_size[0].first())
+            ijk_vec[0] = rng_t(this->ijk[0].first() - 1, this->ijk[0].last());
+
+          ijkm_sep = ijkm;
+          for (int d = 0; d < ct_params_t::n_dims; ++d)
+          {
+            if (this->ijk[d].first() != this->mem->grid_size[d].first())
+            {
+              ijkm_sep.lbound()(d) = this->ijk[d].first();
+              ijkm_sep.ubound()(d) = this->ijk[d].last();
+            }
+          }
+        }
+
         public:
 
         struct rt_params_t : parent_t::rt_params_t
@@ -196,34 +224,13 @@ namespace libmpdataxx
           wrk(args.mem->tmp[__FILE__][4]),
           cdrag(p.cdrag)
         {
-          for (int d = 0; d < ct_params_t::n_dims; ++d)
-          {
-            ijkm.lbound()(d) = this->ijk[d].first() - 1;
-            ijkm.ubound()(d) = this->ijk[d].last();
-
-            ijk_vec[d] = rng_t(this->ijk[d].first(),     this->ijk[d].last());
-          }
-
-          if(ct_params_t::n_dims < 3 && this->rank == 0 // 1D and 2D - sharedmem in x direction
-             ||
-             ct_params_t::n_dims == 3                   // 3D - sharedmem in y direction
-          )
-            ijk_vec[0] = rng_t(this->ijk[0].first() - 1, this->ijk[0].last());
+          set_sgs_ranges();
+        }
 
-          ijkm_sep = ijkm;
-          if (this->rank > 0)
-          {
-            if(ct_params_t::n_dims < 3)
-            {
-              ijkm_sep.lbound()(0) = this->ijk[0].first();
-              ijkm_sep.ubound()(0) = this->ijk[0].last();
-            }
-            else
-            {
-              ijkm_sep.lbound()(1) = this->ijk[1].first();
-              ijkm_sep.ubound()(1) = this->ijk[1].last();
-            }
-          }
+        void set_subdomain(const idx_t<ct_params_t::n_dims> &ijk_new) override
+        {
+          parent_t::set_subdomain(ijk_new);
+          set_sgs_ranges();
         }
 
         static void alloc(
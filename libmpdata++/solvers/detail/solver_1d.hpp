@@ -31,16 +31,24 @@ namespace libmpdataxx
 
         protected:
 
-        const rng_t i; //TODO: to be removed
+        rng_t i; //TODO: to be removed
 
         // generic field used for various statistics (currently Courant number and divergence)
         typename parent_t::arr_t &stat_field; // TODO: should be in solver common but cannot be allocated there ?
 
+        // for a set of arrays (halos going to a given neighbour sent in a single message)
+        void xchng_sclr(const std::vector<typename parent_t::arr_t*> &arrs, const bool deriv = false)
+        {
+          this->mem->barrier_xchng(this->rank);
+          this->xchng_batch(0, [&]{
+            for (auto *arr : arrs) for (auto &bc : this->bcs[0]) bc->fill_halos_sclr(*arr, deriv);
+          });
+          this->mem->barrier_xchng(this->rank);
+        }
+
         virtual void xchng_sclr(typename parent_t::arr_t &arr, const bool deriv = false) final // for a given array
         {
-          this->mem->barrier();
-          for (auto &bc : this->bcs[0]) bc->fill_halos_sclr(arr, deriv);
-          this->mem->barrier();
+          xchng_sclr(std::vector<typename parent_t::arr_t*>{&arr}, deriv);
         }
 
         // no pressure solver in 1D but this function needs to be present for dimension independant code,
@@ -50,14 +58,16 @@ namespace libmpdataxx
           xchng_sclr(arr);
         }
 
-        void xchng(int e) final
+        void xchng_psi(const std::vector<int> &eqns) final
         {
-          xchng_sclr(this->mem->psi[e][ this->n[e]]);
+          std::vector<typename parent_t::arr_t*> arrs;
+          for (const int e : eqns) arrs.push_back(&this->mem->psi[e][ this->n[e]]);
+          xchng_sclr(arrs);
         }
 
         void xchng_vctr_alng(arrvec_t<typename parent_t::arr_t> &arrvec, const bool ad = false, const bool cyclic = false) final
         {
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
           if (!cyclic)
           {
             for (auto &bc : this->bcs[0]) bc->fill_halos_vctr_alng(arrvec, ad);
@@ -66,7 +76,7 @@ namespace libmpdataxx
           {
             for (auto &bc : this->bcs[0]) bc->fill_halos_vctr_alng_cyclic(arrvec, ad);
           }
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void avg_edge_sclr(typename parent_t::arr_t &arr) final
@@ -80,13 +90,13 @@ namespace libmpdataxx
         real_t courant_number(const arrvec_t<typename parent_t::arr_t> &arrvec) final
         {
           stat_field(this->ijk) = real_t(0.5) * (abs(arrvec[0](i+h) + arrvec[0](i-h)));
-          return this->mem->max(this->rank, stat_field(this->ijk));
+          return this->max_over_domain(stat_field);
         }
 
         real_t max_abs_vctr_div(const arrvec_t<typename parent_t::arr_t> &arrvec) final
         {
           stat_field(this->ijk) = abs((arrvec[0](i+h) - arrvec[0](i-h)));
-          return this->mem->max(this->rank, stat_field(this->ijk));
+          return this->max_over_domain(stat_field);
         }
 
         void scale_gc(const real_t time,
@@ -114,6 +124,12 @@ namespace libmpdataxx
           real_t di = 0;
         };
 
+        void set_subdomain(const idx_t<parent_t::n_dims> &ijk_new) override
+        {
+          parent_t::set_subdomain(ijk_new);
+          i = ijk_new[0];
+        }
+
         protected:
 
         // ctor
@@ -32,32 +32,57 @@ namespace libmpdataxx
 
         protected:
 
-        const rng_t i, j; // TODO: to be removed
+        rng_t i, j; // TODO: to be removed
 
         // generic field used for various statistics (currently Courant number and divergence)
         typename parent_t::arr_t &stat_field; // TODO: should be in solver common but cannot be allocated there ?
 
+        // with 2D tiles the corners filled in the first phase of an exchange
+        // may be read by a different thread in the second phase
+        void barrier_if_tiled()
+        {
+          if (this->mem->tiles[1] > 1) this->mem->barrier();
+        }
+
+        // for a set of arrays (halos going to a given neighbour sent in a single message)
+        void xchng_sclr(const std::vector<typename parent_t::arr_t*> &arrs,
+                        const idx_t<2> &range_ijk,
+                        const int ext = 0,
+                        const bool deriv = false
+        )
+        {
+          const auto range_ijk_0__ext = this->extend_range(range_ijk[0], ext);
+          const auto range_ijk_1__ext = this->extend_range_tile(range_ijk[1], ext);
+          this->mem->barrier_xchng(this->rank);
+          this->xchng_batch(0, [&]{
+            for (auto *arr : arrs) for (auto &bc : this->bcs[0]) bc->fill_halos_sclr(*arr, range_ijk_1__ext, deriv);
+          });
+          barrier_if_tiled();
+          this->xchng_batch(1, [&]{
+            for (auto *arr : arrs) for (auto &bc : this->bcs[1]) bc->fill_halos_sclr(*arr, range_ijk_0__ext, deriv);
+          });
+          this->mem->barrier_xchng(this->rank);
+        }
+
         virtual void xchng_sclr(typename parent_t::arr_t &arr,
                         const idx_t<2> &range_ijk,
                         const int ext = 0,
                         const bool deriv = false
         ) final // for a given array
         {
-          const auto range_ijk_0__ext = this->extend_range(range_ijk[0], ext);
-          this->mem->barrier();
-          for (auto &bc : this->bcs[0]) bc->fill_halos_sclr(arr, range_ijk[1]^ext, deriv);
-          for (auto &bc : this->bcs[1]) bc->fill_halos_sclr(arr, range_ijk_0__ext, deriv);
-          this->mem->barrier();
+          xchng_sclr(std::vector<typename parent_t::arr_t*>{&arr}, range_ijk, ext, deriv);
         }
 
-        void xchng(int e) final
+        void xchng_psi(const std::vector<int> &eqns) final
         {
-          this->xchng_sclr(this->mem->psi[e][ this->n[e]], this->ijk, this->halo);
+          std::vector<typename parent_t::arr_t*> arrs;
+          for (const int e : eqns) arrs.push_back(&this->mem->psi[e][ this->n[e]]);
+          this->xchng_sclr(arrs, this->ijk, this->halo);
         }
 
         void xchng_vctr_alng(arrvec_t<typename parent_t::arr_t> &arrvec, const bool ad = false, const bool cyclic = false) final
         {
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
           if (!cyclic)
           {
             for (auto &bc : this->bcs[0]) bc->fill_halos_vctr_alng(arrvec, j, ad);
@@ -69,15 +94,15 @@ namespace libmpdataxx
             for (auto &bc : this->bcs[1]) bc->fill_halos_vctr_alng_cyclic(arrvec, i, ad);
           }
           // TODO: open bc nust be last!!!
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void xchng_flux(arrvec_t<typename parent_t::arr_t> &arrvec) final
         {
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
           for (auto &bc : this->bcs[0]) bc->fill_halos_flux(arrvec, j);
           for (auto &bc : this->bcs[1]) bc->fill_halos_flux(arrvec, i);
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void xchng_sgs_div(
@@ -85,10 +110,11 @@ namespace libmpdataxx
           const idx_t<2> &range_ijk
         ) final
         {
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
           for (auto &bc : this->bcs[1]) bc->fill_halos_sgs_div_stgr(arr, range_ijk[0]); // vip_div is staggered in vertical
-          for (auto &bc : this->bcs[0]) bc->fill_halos_sgs_div(arr, range_ijk[1]^h);
-          this->mem->barrier();
+          barrier_if_tiled();
+          for (auto &bc : this->bcs[0]) bc->fill_halos_sgs_div(arr, this->extend_range_tile(range_ijk[1], h));
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void xchng_sgs_vctr(arrvec_t<typename parent_t::arr_t> &av,
@@ -96,10 +122,10 @@ namespace libmpdataxx
                             const idx_t<2> &range_ijk
         ) final
         {
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
           for (auto &bc : this->bcs[0]) bc->fill_halos_sgs_vctr(av, b, range_ijk[1]);
           for (auto &bc : this->bcs[1]) bc->fill_halos_sgs_vctr(av, b, range_ijk[0]);
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void xchng_sgs_tnsr_diag(arrvec_t<typename parent_t::arr_t> &av,
@@ -108,10 +134,10 @@ namespace libmpdataxx
                                          const idx_t<2> &range_ijk
         ) final
         {
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
           for (auto &bc : this->bcs[0]) bc->fill_halos_sgs_tnsr(av, w, vip_div, range_ijk[1], this->dijk[0]);
           for (auto &bc : this->bcs[1]) bc->fill_halos_sgs_tnsr(av, w, vip_div, range_ijk[0], this->dijk[1]);
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void xchng_sgs_tnsr_offdiag(arrvec_t<typename parent_t::arr_t> &av,
@@ -122,10 +148,10 @@ namespace libmpdataxx
         {
 
           // off-diagonal components of stress tensor are treated the same as a vector
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
           for (auto &bc : this->bcs[0]) bc->fill_halos_sgs_vctr(av, bv[0], range_ijkm[1], 2);
           for (auto &bc : this->bcs[1]) bc->fill_halos_sgs_vctr(av, bv[0], range_ijkm[0], 1);
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void xchng_vctr_nrml(
@@ -137,18 +163,19 @@ namespace libmpdataxx
         {
 
           const auto range_ijk_0__ext_h = this->extend_range(range_ijk[0], ext, h);
-          this->mem->barrier();
+          const auto range_ijk_1__ext_h = this->extend_range_tile(range_ijk[1], ext, h);
+          this->mem->barrier_xchng(this->rank);
           if (!cyclic)
           {
             for (auto &bc : this->bcs[1]) bc->fill_halos_vctr_nrml(arrvec[0], range_ijk_0__ext_h);
-            for (auto &bc : this->bcs[0]) bc->fill_halos_vctr_nrml(arrvec[1], range_ijk[1]^ext^h);
+            for (auto &bc : this->bcs[0]) bc->fill_halos_vctr_nrml(arrvec[1], range_ijk_1__ext_h);
           }
           else
           {
             for (auto &bc : this->bcs[1]) bc->fill_halos_vctr_nrml_cyclic(arrvec[0], range_ijk_0__ext_h);
-            for (auto &bc : this->bcs[0]) bc->fill_halos_vctr_nrml_cyclic(arrvec[1], range_ijk[1]^ext^h);
+            for (auto &bc : this->bcs[0]) bc->fill_halos_vctr_nrml_cyclic(arrvec[1], range_ijk_1__ext_h);
           }
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void xchng_pres(
@@ -158,10 +185,12 @@ namespace libmpdataxx
         ) final
         {
           const auto range_ijk_0__ext = this->extend_range(range_ijk[0], ext);
-          this->mem->barrier();
-          for (auto &bc : this->bcs[0]) bc->fill_halos_pres(arr, range_ijk[1]^ext);
+          const auto range_ijk_1__ext = this->extend_range_tile(range_ijk[1], ext);
+          this->mem->barrier_xchng(this->rank);
+          for (auto &bc : this->bcs[0]) bc->fill_halos_pres(arr, range_ijk_1__ext);
+          barrier_if_tiled();
           for (auto &bc : this->bcs[1]) bc->fill_halos_pres(arr, range_ijk_0__ext);
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void set_edges(
@@ -223,7 +252,7 @@ namespace libmpdataxx
                                            abs(arrvec[0](i+h, j) + arrvec[0](i-h, j))
                                          + abs(arrvec[1](i, j+h) + arrvec[1](i, j-h))
                                         ) / formulae::G<ct_params_t::opts, 0>(*this->mem->G, i, j);
-          return this->mem->max(this->rank, stat_field(this->ijk));
+          return this->max_over_domain(stat_field);
         }
 
         real_t max_abs_vctr_div(const arrvec_t<typename parent_t::arr_t> &arrvec) final
@@ -232,7 +261,7 @@ namespace libmpdataxx
                                         (arrvec[0](i+h, j) - arrvec[0](i-h, j))
                                       + (arrvec[1](i, j+h) - arrvec[1](i, j-h))
                                      ) / formulae::G<ct_params_t::opts, 0>(*this->mem->G, i, j);
-          return this->mem->max(this->rank, stat_field(this->ijk));
+          return this->max_over_domain(stat_field);
         }
 
         void scale_gc(const real_t time,
@@ -263,6 +292,13 @@ namespace libmpdataxx
           real_t di = 0, dj = 0;
         };
 
+        void set_subdomain(const idx_t<parent_t::n_dims> &ijk_new) override
+        {
+          parent_t::set_subdomain(ijk_new);
+          i = ijk_new[0];
+          j = ijk_new[1];
+        }
+
         protected:
 
         // ctor
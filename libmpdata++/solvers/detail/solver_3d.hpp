@@ -26,9 +26,11 @@ namespace libmpdataxx
       {
         using parent_t = solver_common<ct_params_t, n_tlev, minhalo>;
 
-        void barrier_if_single_threaded_bc0()
+        // with 2D tiles more than one thread shares the x-edges of the domain and the halos
+        // filled in one phase of an exchange may be read by a different thread in the next one
+        void barrier_if_tiled()
         {
-          if(this->bcs[0].at(0)->single_threaded || this->bcs[0].at(1)->single_threaded) this->mem->barrier();
+          if (this->mem->tiles[1] > 1) this->mem->barrier();
         }
 
         public:
@@ -37,61 +39,113 @@ namespace libmpdataxx
 
         protected:
 
-        const rng_t i, j, k; // TODO: we have ijk in solver_common - could it be removed?
+        rng_t i, j, k; // TODO: we have ijk in solver_common - could it be removed?
 
         // generic field used for various statistics (currently Courant number and divergence)
         typename parent_t::arr_t &stat_field; // TODO:/: should be in solver common but cannot be allocated there ?
 
         // NOTE: for ext > 0 fill_halos_sclr in different directions could lead to race conditions when different bconds try to write to the same point of halo?
         //       this does not seem to happen...
+        // for a set of arrays (halos going to a given neighbour sent in a single message)
+        void xchng_sclr(const std::vector<typename parent_t::arr_t*> &arrs,
+                       const idx_t<3> &range_ijk,
+                       const int ext = 0,
+                       const bool deriv = false
+        )
+        {
+          const auto range_ijk_1__ext = this->extend_range(range_ijk[1], ext);
+          this->mem->barrier_xchng(this->rank);
+          this->xchng_batch(1, [&]{
+            for (auto *arr : arrs) for (auto &bc : this->bcs[1]) bc->fill_halos_sclr(*arr, range_ijk[2]^ext, this->extend_range_tile(range_ijk[0], ext), deriv);
+          });
+          barrier_if_tiled();
+          this->xchng_batch(0, [&]{
+            for (auto *arr : arrs) for (auto &bc : this->bcs[0]) bc->fill_halos_sclr(*arr, range_ijk_1__ext, range_ijk[2]^ext, deriv);
+          });
+          barrier_if_tiled();
+          this->xchng_batch(2, [&]{
+            for (auto *arr : arrs) for (auto &bc : this->bcs[2]) bc->fill_halos_sclr(*arr, this->extend_range_tile(range_ijk[0], ext), range_ijk_1__ext, deriv);
+          });
+          this->mem->barrier_xchng(this->rank);
+        }
+
         virtual void xchng_sclr(typename parent_t::arr_t &arr,
                        const idx_t<3> &range_ijk,
                        const int ext = 0,
                        const bool deriv = false
         ) final // for a given array
         {
-          const auto range_ijk_1__ext = this->extend_range(range_ijk[1], ext);
-          this->mem->barrier();
-          for (auto &bc : this->bcs[1]) bc->fill_halos_sclr(arr, range_ijk[2]^ext, range_ijk[0]^ext, deriv);
-          barrier_if_single_threaded_bc0();
-          for (auto &bc : this->bcs[0]) bc->single_threaded ? bc->fill_halos_sclr(arr, range_ijk[1]^ext, range_ijk[2]^ext, deriv) : bc->fill_halos_sclr(arr, range_ijk_1__ext, range_ijk[2]^ext, deriv);
-          barrier_if_single_threaded_bc0();
-          for (auto &bc : this->bcs[2]) bc->fill_halos_sclr(arr, range_ijk[0]^ext, range_ijk_1__ext, deriv);
-          this->mem->barrier();
+          xchng_sclr(std::vector<typename parent_t::arr_t*>{&arr}, range_ijk, ext, deriv);
+        }
+
+        // split-phase exchange of psi[e][n[e]] halos overlapping the remote x exchange with computations
+        // (see sharedmem::xchng_overlap): xchng_begin() fills the y and z halos and starts filling
+        // the x ones, including all the corners sent along from the neighbours' y and z halos;
+        // until xchng_end() the x halos must not be read nor the psi interior written to;
+        // returns false if the exchange was done at once (e.g. with the halos still valid)
+        bool xchng_begin(const int e)
+        {
+          auto &psi = this->mem->psi[e][ this->n[e]];
+          if (!this->mem->xchng_overlap || this->halo_valid.count(psi.data()) != 0)
+          {
+            this->xchng(e);
+            return false;
+          }
+
+          const int ext = this->halo;
+          const auto range_ijk_1__ext = this->extend_range(this->ijk[1], ext);
+          this->mem->barrier_xchng(this->rank);
+          for (auto &bc : this->bcs[1]) bc->fill_halos_sclr(psi, this->ijk[2]^ext, this->ijk[0], false);
+          for (auto &bc : this->bcs[2]) bc->fill_halos_sclr(psi, this->ijk[0], range_ijk_1__ext, false);
+          barrier_if_tiled();
+          for (auto &bc : this->bcs[0]) bc->batch_begin();
+          for (auto &bc : this->bcs[0]) bc->fill_halos_sclr(psi, range_ijk_1__ext, this->ijk[2]^ext, false);
+          for (auto &bc : this->bcs[0]) bc->batch_start();
+          return true;
         }
-        void xchng(int e) final
+
+        void xchng_end(const int e)
+        {
+          for (auto &bc : this->bcs[0]) bc->batch_wait();
+          this->mem->barrier_xchng(this->rank);
+          if (this->halo_skip) this->halo_valid.insert(this->mem->psi[e][ this->n[e]].data());
+        }
+
+        void xchng_psi(const std::vector<int> &eqns) final
         {
-          this->xchng_sclr(this->mem->psi[e][ this->n[e]], this->ijk, this->halo);
+          std::vector<typename parent_t::arr_t*> arrs;
+          for (const int e : eqns) arrs.push_back(&this->mem->psi[e][ this->n[e]]);
+          this->xchng_sclr(arrs, this->ijk, this->halo);
         }
 
         void xchng_vctr_alng(arrvec_t<typename parent_t::arr_t> &arrvec, const bool ad = false, const bool cyclic = false) final
         {
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
           if (!cyclic)
           {
             for (auto &bc : this->bcs[0]) bc->fill_halos_vctr_alng(arrvec, j, k, ad);
-            barrier_if_single_threaded_bc0();
+            barrier_if_tiled();
             for (auto &bc : this->bcs[1]) bc->fill_halos_vctr_alng(arrvec, k, i, ad);
             for (auto &bc : this->bcs[2]) bc->fill_halos_vctr_alng(arrvec, i, j, ad);
           }
           else
           {
             for (auto &bc : this->bcs[0]) bc->fill_halos_vctr_alng_cyclic(arrvec, j, k, ad);
-            barrier_if_single_threaded_bc0();
+            barrier_if_tiled();
             for (auto &bc : this->bcs[1]) bc->fill_halos_vctr_alng_cyclic(arrvec, k, i, ad);
             for (auto &bc : this->bcs[2]) bc->fill_halos_vctr_alng_cyclic(arrvec, i, j, ad);
           }
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void xchng_flux(arrvec_t<typename parent_t::arr_t> &arrvec) final
         {
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
           for (auto &bc : this->bcs[0]) bc->fill_halos_flux(arrvec, j, k);
-          barrier_if_single_threaded_bc0();
+          barrier_if_tiled();
           for (auto &bc : this->bcs[1]) bc->fill_halos_flux(arrvec, k, i);
           for (auto &bc : this->bcs[2]) bc->fill_halos_flux(arrvec, i, j);
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void xchng_sgs_div(
@@ -99,12 +153,12 @@ namespace libmpdataxx
           const idx_t<3> &range_ijk
         ) final
         {
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
           for (auto &bc : this->bcs[2]) bc->fill_halos_sgs_div_stgr(arr, range_ijk[0], range_ijk[1]); // vip_div is staggered in vertical
           for (auto &bc : this->bcs[1]) bc->fill_halos_sgs_div(arr, range_ijk[2]^h, range_ijk[0]);
-          barrier_if_single_threaded_bc0(); // to make sure that all threads have filled range_ijk[2]^h before it is used to fill along x 
+          barrier_if_tiled(); // to make sure that all threads have filled range_ijk[2]^h before it is used to fill along x 
           for (auto &bc : this->bcs[0]) bc->fill_halos_sgs_div(arr, range_ijk[1], range_ijk[2]^h);
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void xchng_sgs_vctr(arrvec_t<typename parent_t::arr_t> &av,
@@ -112,12 +166,12 @@ namespace libmpdataxx
                                     const idx_t<3> &range_ijk
         ) final
         {
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
           for (auto &bc : this->bcs[0]) bc->fill_halos_sgs_vctr(av, b, range_ijk[1], range_ijk[2]);
-          barrier_if_single_threaded_bc0();
+          barrier_if_tiled();
           for (auto &bc : this->bcs[1]) bc->fill_halos_sgs_vctr(av, b, range_ijk[2], range_ijk[0]);
           for (auto &bc : this->bcs[2]) bc->fill_halos_sgs_vctr(av, b, range_ijk[0], range_ijk[1]);
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void xchng_sgs_tnsr_diag(arrvec_t<typename parent_t::arr_t> &av,
@@ -126,12 +180,12 @@ namespace libmpdataxx
                                          const idx_t<3> &range_ijk
         ) final
         {
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
           for (auto &bc : this->bcs[0]) bc->fill_halos_sgs_tnsr(av, w, vip_div, range_ijk[1], range_ijk[2], this->dijk[0]);
-          barrier_if_single_threaded_bc0();
+          barrier_if_tiled();
           for (auto &bc : this->bcs[1]) bc->fill_halos_sgs_tnsr(av, w, vip_div, range_ijk[2], range_ijk[0], this->dijk[1]);
           for (auto &bc : this->bcs[2]) bc->fill_halos_sgs_tnsr(av, w, vip_div, range_ijk[0], range_ijk[1], this->dijk[2]);
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void xchng_sgs_tnsr_offdiag(arrvec_t<typename parent_t::arr_t> &av,
@@ -141,26 +195,32 @@ namespace libmpdataxx
         ) final
         {
           // off-diagonal components of stress tensor are treated the same as a vector
-          this->mem->barrier();
-          for (auto &bc : this->bcs[0])
-          {
-            bc->fill_halos_sgs_vctr(av, bv[0], range_ijkm[1], range_ijk[2]^1, 3);
-            bc->fill_halos_sgs_vctr(av, bv[1], range_ijk[1]^1, range_ijkm[2], 4);
-          }
-          barrier_if_single_threaded_bc0();
+          this->mem->barrier_xchng(this->rank);
+          this->xchng_batch(0, [&]{
+            for (auto &bc : this->bcs[0])
+            {
+              bc->fill_halos_sgs_vctr(av, bv[0], range_ijkm[1], range_ijk[2]^1, 3);
+              bc->fill_halos_sgs_vctr(av, bv[1], range_ijk[1]^1, range_ijkm[2], 4);
+            }
+          });
+          barrier_if_tiled();
 
-          for (auto &bc : this->bcs[1])
-          {
-            bc->fill_halos_sgs_vctr(av, bv[0], range_ijk[2]^1, range_ijkm[0], 2);
-            bc->fill_halos_sgs_vctr(av, bv[1], range_ijkm[2], range_ijk[0]^1, 4);
-          }
+          this->xchng_batch(1, [&]{
+            for (auto &bc : this->bcs[1])
+            {
+              bc->fill_halos_sgs_vctr(av, bv[0], range_ijk[2]^1, range_ijkm[0], 2);
+              bc->fill_halos_sgs_vctr(av, bv[1], range_ijkm[2], range_ijk[0]^1, 4);
+            }
+          });
 
-          for (auto &bc : this->bcs[2])
-          {
-            bc->fill_halos_sgs_vctr(av, bv[0], range_ijkm[0], range_ijk[1]^1, 2);
-            bc->fill_halos_sgs_vctr(av, bv[1], range_ijk[0]^1, range_ijkm[1], 3);
-          }
-          this->mem->barrier();
+          this->xchng_batch(2, [&]{
+            for (auto &bc : this->bcs[2])
+            {
+              bc->fill_halos_sgs_vctr(av, bv[0], range_ijkm[0], range_ijk[1]^1, 2);
+              bc->fill_halos_sgs_vctr(av, bv[1], range_ijk[0]^1, range_ijkm[1], 3);
+            }
+          });
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void xchng_vctr_nrml(
@@ -170,12 +230,15 @@ namespace libmpdataxx
           const bool cyclic = false
         ) final
         {
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
           const auto range_ijk_1__ext_h = this->extend_range(range_ijk[1], ext, h);
           const auto range_ijk_1__ext_1 = this->extend_range(range_ijk[1], ext, 1);
+          // the components are exchanged in the order y(0) x(1,2) z(0,1) y(2), which keeps the order
+          // of dimensions for each component and lets the halos of two components going to a given
+          // neighbour be sent in one message (see xchng_batch())
           if (!cyclic)
           {
-            for (auto &bc : this->bcs[1]) bc->fill_halos_vctr_nrml(arrvec[0], range_ijk[2]^ext^1, range_ijk[0]^ext^h);
+            for (auto &bc : this->bcs[1]) bc->fill_halos_vctr_nrml(arrvec[0], range_ijk[2]^ext^1, this->extend_range_tile(range_ijk[0], ext, h));
 
             // without this barrier, there is a race condition when some threads handle subdomains
             // with one gridpoint width, the problem manifests itself, for example, in pbl test
@@ -183,41 +246,42 @@ namespace libmpdataxx
             //       what about atypical boundary condition choices -- rigid/cyclic/rigid etc
             if (parent_t::div3_mpdata)
             {
-              this->mem->barrier();
+              this->mem->barrier_xchng(this->rank);
             }
 
-            for (auto &bc : this->bcs[2]) bc->fill_halos_vctr_nrml(arrvec[0], range_ijk[0]^ext^h, range_ijk_1__ext_1);
+            barrier_if_tiled();
+            this->xchng_batch(0, [&]{
+              for (auto &bc : this->bcs[0]) bc->fill_halos_vctr_nrml(arrvec[1], range_ijk_1__ext_h, range_ijk[2]^ext^1);
+              for (auto &bc : this->bcs[0]) bc->fill_halos_vctr_nrml(arrvec[2], range_ijk_1__ext_1, range_ijk[2]^ext^h);
+            });
+            barrier_if_tiled();
 
-            barrier_if_single_threaded_bc0();
-            for (auto &bc : this->bcs[0]) bc->single_threaded ? bc->fill_halos_vctr_nrml(arrvec[1], range_ijk[1]^ext^h, range_ijk[2]^ext^1) : bc->fill_halos_vctr_nrml(arrvec[1], range_ijk_1__ext_h, range_ijk[2]^ext^1);
-            barrier_if_single_threaded_bc0();
+            this->xchng_batch(2, [&]{
+              for (auto &bc : this->bcs[2]) bc->fill_halos_vctr_nrml(arrvec[0], this->extend_range_tile(range_ijk[0], ext, h), range_ijk_1__ext_1);
+              for (auto &bc : this->bcs[2]) bc->fill_halos_vctr_nrml(arrvec[1], this->extend_range_tile(range_ijk[0], ext, 1), range_ijk_1__ext_h);
+            });
 
-            for (auto &bc : this->bcs[2]) bc->fill_halos_vctr_nrml(arrvec[1], range_ijk[0]^ext^1, range_ijk_1__ext_h);
-
-            barrier_if_single_threaded_bc0();
-            for (auto &bc : this->bcs[0]) bc->single_threaded ? bc->fill_halos_vctr_nrml(arrvec[2], range_ijk[1]^ext^1, range_ijk[2]^ext^h) : bc->fill_halos_vctr_nrml(arrvec[2], range_ijk_1__ext_1, range_ijk[2]^ext^h);
-            barrier_if_single_threaded_bc0();
-
-            for (auto &bc : this->bcs[1]) bc->fill_halos_vctr_nrml(arrvec[2], range_ijk[2]^ext^h, range_ijk[0]^ext^1);
+            for (auto &bc : this->bcs[1]) bc->fill_halos_vctr_nrml(arrvec[2], range_ijk[2]^ext^h, this->extend_range_tile(range_ijk[0], ext, 1));
           }
           else
           {
-            for (auto &bc : this->bcs[1]) bc->fill_halos_vctr_nrml_cyclic(arrvec[0], range_ijk[2]^ext^1, range_ijk[0]^ext^h);
-            for (auto &bc : this->bcs[2]) bc->fill_halos_vctr_nrml_cyclic(arrvec[0], range_ijk[0]^ext^h, range_ijk_1__ext_1);
-
-            barrier_if_single_threaded_bc0();
-            for (auto &bc : this->bcs[0]) bc->single_threaded ? bc->fill_halos_vctr_nrml_cyclic(arrvec[1], range_ijk[1]^ext^h, range_ijk[2]^ext^1) : bc->fill_halos_vctr_nrml_cyclic(arrvec[1], range_ijk_1__ext_h, range_ijk[2]^ext^1);
-            barrier_if_single_threaded_bc0();
+            for (auto &bc : this->bcs[1]) bc->fill_halos_vctr_nrml_cyclic(arrvec[0], range_ijk[2]^ext^1, this->extend_range_tile(range_ijk[0], ext, h));
 
-            for (auto &bc : this->bcs[2]) bc->fill_halos_vctr_nrml_cyclic(arrvec[1], range_ijk[0]^ext^1, range_ijk_1__ext_h);
+            barrier_if_tiled();
+            this->xchng_batch(0, [&]{
+              for (auto &bc : this->bcs[0]) bc->fill_halos_vctr_nrml_cyclic(arrvec[1], range_ijk_1__ext_h, range_ijk[2]^ext^1);
+              for (auto &bc : this->bcs[0]) bc->fill_halos_vctr_nrml_cyclic(arrvec[2], range_ijk_1__ext_1, range_ijk[2]^ext^h);
+            });
+            barrier_if_tiled();
 
-            barrier_if_single_threaded_bc0();
-            for (auto &bc : this->bcs[0]) bc->single_threaded ? bc->fill_halos_vctr_nrml_cyclic(arrvec[2], range_ijk[1]^ext^1, range_ijk[2]^ext^h) : bc->fill_halos_vctr_nrml_cyclic(arrvec[2], range_ijk_1__ext_1, range_ijk[2]^ext^h);
-            barrier_if_single_threaded_bc0();
+            this->xchng_batch(2, [&]{
+              for (auto &bc : this->bcs[2]) bc->fill_halos_vctr_nrml_cyclic(arrvec[0], this->extend_range_tile(range_ijk[0], ext, h), range_ijk_1__ext_1);
+              for (auto &bc : this->bcs[2]) bc->fill_halos_vctr_nrml_cyclic(arrvec[1], this->extend_range_tile(range_ijk[0], ext, 1), range_ijk_1__ext_h);
+            });
 
-            for (auto &bc : this->bcs[1]) bc->fill_halos_vctr_nrml_cyclic(arrvec[2], range_ijk[2]^ext^h, range_ijk[0]^ext^1);
+            for (auto &bc : this->bcs[1]) bc->fill_halos_vctr_nrml_cyclic(arrvec[2], range_ijk[2]^ext^h, this->extend_range_tile(range_ijk[0], ext, 1));
           }
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void xchng_pres(
@@ -227,12 +291,12 @@ namespace libmpdataxx
         ) final
         {
           const auto range_ijk_1__ext = this->extend_range(range_ijk[1], ext);
-          this->mem->barrier();
-          for (auto &bc : this->bcs[0]) bc->single_threaded ? bc->fill_halos_pres(arr, range_ijk[1]^ext, range_ijk[2]^ext) : bc->fill_halos_pres(arr, range_ijk_1__ext, range_ijk[2]^ext);
-          barrier_if_single_threaded_bc0();
-          for (auto &bc : this->bcs[1]) bc->fill_halos_pres(arr, range_ijk[2]^ext, range_ijk[0]^ext);
-          for (auto &bc : this->bcs[2]) bc->fill_halos_pres(arr, range_ijk[0]^ext, range_ijk_1__ext);
-          this->mem->barrier();
+          this->mem->barrier_xchng(this->rank);
+          for (auto &bc : this->bcs[0]) bc->fill_halos_pres(arr, range_ijk_1__ext, range_ijk[2]^ext);
+          barrier_if_tiled();
+          for (auto &bc : this->bcs[1]) bc->fill_halos_pres(arr, range_ijk[2]^ext, this->extend_range_tile(range_ijk[0], ext));
+          for (auto &bc : this->bcs[2]) bc->fill_halos_pres(arr, this->extend_range_tile(range_ijk[0], ext), range_ijk_1__ext);
+          this->mem->barrier_xchng(this->rank);
         }
 
         virtual void set_edges(
@@ -243,7 +307,7 @@ namespace libmpdataxx
         {
           this->mem->barrier();
           for (auto &bc : this->bcs[0]) bc->set_edge_pres(av[0], range_ijk[1], range_ijk[2], sign);
-          barrier_if_single_threaded_bc0();
+          barrier_if_tiled();
           for (auto &bc : this->bcs[1]) bc->set_edge_pres(av[1], range_ijk[2], range_ijk[0], sign);
           for (auto &bc : this->bcs[2]) bc->set_edge_pres(av[2], range_ijk[0], range_ijk[1], sign);
           this->mem->barrier();
@@ -256,7 +320,7 @@ namespace libmpdataxx
         {
           this->mem->barrier();
           for (auto &bc : this->bcs[0]) bc->save_edge_vel(av[0], range_ijk[1], range_ijk[2]);
-          barrier_if_single_threaded_bc0();
+          barrier_if_tiled();
           for (auto &bc : this->bcs[1]) bc->save_edge_vel(av[1], range_ijk[2], range_ijk[0]);
           for (auto &bc : this->bcs[2]) bc->save_edge_vel(av[2], range_ijk[0], range_ijk[1]);
           this->mem->barrier();
@@ -269,7 +333,7 @@ namespace libmpdataxx
           this->mem->barrier();
 
           for (auto &bc : this->bcs[0]) bc->copy_edge_sclr_to_halo1_cyclic(arr, range_ijk[1], range_ijk[2]);
-//          barrier_if_single_threaded_bc0(); // not necessary?
+//          barrier_if_tiled(); // not necessary?
           for (auto &bc : this->bcs[1]) bc->copy_edge_sclr_to_halo1_cyclic(arr, range_ijk[2], range_ijk[0]);
           for (auto &bc : this->bcs[2]) bc->copy_edge_sclr_to_halo1_cyclic(arr, range_ijk[0], range_ijk[1]);
           this->mem->barrier(); // wait for all threads to copy edge to halo before modifying edge. 
@@ -303,7 +367,7 @@ namespace libmpdataxx
                                           + abs(arrvec[1](i, j+h, k) + arrvec[1](i, j-h, k))
                                           + abs(arrvec[2](i, j, k+h) + arrvec[2](i, j, k-h))
                                          ) / formulae::G<ct_params_t::opts, 0>(*this->mem->G, i, j, k);
-          return this->mem->max(this->rank, stat_field(this->ijk));
+          return this->max_over_domain(stat_field);
         }
 
         real_t max_abs_vctr_div(const arrvec_t<typename parent_t::arr_t> &arrvec) final
@@ -314,7 +378,7 @@ namespace libmpdataxx
                                        + (arrvec[2](i, j, k+h) - arrvec[2](i, j, k-h))
                                       ) / formulae::G<ct_params_t::opts, 0>(*this->mem->G, i, j, k);
 
-          return this->mem->max(this->rank, stat_field(this->ijk));
+          return this->max_over_domain(stat_field);
         }
 
         void scale_gc(const real_t time,
@@ -349,6 +413,14 @@ namespace libmpdataxx
           real_t di = 0, dj = 0, dk = 0;
         };
 
+        void set_subdomain(const idx_t<parent_t::n_dims> &ijk_new) override
+        {
+          parent_t::set_subdomain(ijk_new);
+          i = ijk_new[0];
+          j = ijk_new[1];
+          k = ijk_new[2];
+        }
+
         protected:
 
         // ctor
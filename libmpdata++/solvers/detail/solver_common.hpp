@@ -14,7 +14,12 @@
 
 #include <libmpdata++/bcond/detail/bcond_common.hpp>
 
+#include <algorithm>
 #include <array>
+#include <numeric>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 namespace libmpdataxx
 {
@@ -66,10 +71,14 @@ namespace libmpdataxx
         std::array<real_t, div3_mpdata ? 2 : 1> dt_stash;
         std::array<real_t, n_dims> dijk;
 
-        const idx_t<n_dims> ijk;
+        idx_t<n_dims> ijk; // changed only by set_subdomain()
 
         long long int timestep = 0;
         real_t time = 0;
+
+        // temporal blocking: each advop() call advancing the advectee by block_steps time steps,
+        // up to time_block, with the blocks aligned to multiples of time_block (see mpdata_common)
+        int time_block = 1, block_steps = 1;
         std::vector<int> n;
 
         typedef concurr::detail::sharedmem<real_t, n_dims, n_tlev> mem_t;
@@ -91,11 +100,104 @@ namespace libmpdataxx
         virtual void cycle(int e) final
         {
           n[e] = (n[e] + 1) % n_tlev - n_tlev;  // -n_tlev so that n+1 does not give out of bounds
+          invalidate_halo(mem->psi[e][n[e]]); // the new psi[n] has just been written
           if(is_last_eqn(e)) mem->cycle(rank);
         }
 
-        virtual void xchng(int e) = 0;
-        // TODO: implement flagging of valid/invalid halo for optimisations
+        // halo validity tracking for advectees (only if halo_skip is set): psi[e][n[e]] arrays whose halos
+        // were filled (to the full depth) by xchng(e) and not written to since; the record is per thread
+        // and the decisions are taken without any communication, hence it is opt-in: the solvers do the same
+        // writes and exchanges in all threads, but any other write to the advectees (e.g. through
+        // mem->advectee() within a hook) has to be followed by invalidate_halo() in all threads
+        const bool halo_skip;
+        std::unordered_set<const real_t*> halo_valid;
+
+        void invalidate_halo(const arr_t &arr)
+        {
+          halo_valid.erase(arr.data());
+        }
+
+        // unconditional exchange of psi[e][n[e]] halos of the given equations, dimension-specific;
+        // halos of all the arrays going to a given neighbour are sent in one message (see xchng_batch())
+        virtual void xchng_psi(const std::vector<int> &eqns) = 0;
+
+        // fills halos in dimension d of all arrays passed to bcs[d] within fill()
+        // exchanging a single message per neighbouring process instead of one per array (if mpi_batch)
+        const bool mpi_batch;
+
+        template <class fill_t>
+        void xchng_batch(const int d, const fill_t &fill)
+        {
+          if (!mpi_batch)
+          {
+            fill();
+            return;
+          }
+          for (auto &bc : bcs[d]) bc->batch_begin();
+          fill();
+          for (auto &bc : bcs[d]) bc->batch_start();
+          for (auto &bc : bcs[d]) bc->batch_wait();
+        }
+
+        // exchange of psi[e][n[e]] halos of the given equations, skipping those still valid (if halo_skip)
+        void xchng(const std::vector<int> &eqns)
+        {
+          if (!halo_skip)
+          {
+            xchng_psi(eqns);
+            return;
+          }
+
+          std::vector<int> stale;
+          for (const int e : eqns)
+          {
+            if (halo_valid.count(mem->psi[e][n[e]].data()) == 0) stale.push_back(e);
+          }
+
+#if defined(NDEBUG)
+          if (stale.empty())
+            // keeping the synchronisation that the exchange would have provided
+            mem->barrier_xchng(rank);
+          else
+            xchng_psi(stale);
+#else
+          // debug mode: exchanging the valid halos as well and checking that it did not change them;
+          // the halo regions of a thread are written to by the neighbouring threads too, hence
+          // the copies and the comparisons are done while no thread is exchanging
+          const blitz::TinyVector<int, n_dims> lo = ijk.lbound() - int(halo), hi = ijk.ubound() + int(halo);
+          const idx_t<n_dims> ijk_h(lo, hi);
+          std::vector<std::pair<int, arr_t>> before;
+          mem->barrier();
+          for (const int e : eqns)
+            if (std::find(stale.begin(), stale.end(), e) == stale.end())
+              before.emplace_back(e, mem->psi[e][n[e]](ijk_h).copy());
+          mem->barrier();
+          xchng_psi(eqns);
+          mem->barrier();
+          for (const auto &b : before)
+          {
+            const auto &psi = mem->psi[b.first][n[b.first]];
+            assert(all(b.second == psi(ijk_h) || (b.second != b.second && psi(ijk_h) != psi(ijk_h))) // NaN-tolerant
+              && "skipped halo exchange would have changed the halo (missing invalidate_halo() call?)");
+          }
+          mem->barrier();
+#endif
+
+          for (const int e : stale) halo_valid.insert(mem->psi[e][n[e]].data());
+        }
+
+        void xchng(int e)
+        {
+          xchng(std::vector<int>{e});
+        }
+
+        // exchange of halos of all advectees
+        void xchng_eqns()
+        {
+          std::vector<int> eqns(n_eqns);
+          std::iota(eqns.begin(), eqns.end(), 0);
+          xchng(eqns);
+        }
 
         virtual void xchng_vctr_alng(arrvec_t<arr_t>&, const bool ad = false, const bool cyclic = false) = 0;
 
@@ -103,8 +205,8 @@ namespace libmpdataxx
         {
           // with distributed memory and cyclic boundary conditions,
           // leftmost node must send left first, as
-          // rightmost node is waiting
-          if (d == 0 && this->mem->distmem.size() > 0 && this->mem->distmem.rank() == 0)
+          // rightmost node is waiting (in each MPI-decomposed dimension)
+          if ((d == 0 || this->mem->distmem.cart_dims[d] > 1) && this->mem->distmem.cart_coords[d] == 0)
             std::swap(bcl, bcr);
 
           bcs[d][0] = std::move(bcl);
@@ -114,6 +216,12 @@ namespace libmpdataxx
         virtual real_t courant_number(const arrvec_t<arr_t>&) = 0;
         virtual real_t max_abs_vctr_div(const arrvec_t<arr_t>&) = 0;
 
+        // maximum of a field over the whole domain, used by the above
+        real_t max_over_domain(const arr_t &arr)
+        {
+          return mem->reduce(rank, {mem_t::max_of(arr)}, ijk, false)[0];
+        }
+
         // return false if advector does not change in time
         virtual bool calc_gc() {return false;}
 
@@ -122,25 +230,64 @@ namespace libmpdataxx
 
         virtual void scale_gc(const real_t time, const real_t cur_dt, const real_t prev_dt) = 0;
 
+        // per-step schedule of the equations (non-delayed ones first, then the delayed ones):
+        // set of scratch arrays used by each equation and whether a barrier is needed after it;
+        // with more than one scratch set (eqn_overlap) consecutive equations of the same group
+        // alternate between the sets and do not depend on each other, reuse of a set by
+        // the next but one equation is ordered by the flux exchange (a barrier) inside advop()
+        std::array<int, n_eqns> eqn_scratch;
+        std::array<bool, n_eqns> eqn_barrier;
+
+        void schedule_eqns()
+        {
+          std::vector<int> order;
+          for (const bool delayed : {false, true})
+            for (int e = 0; e < n_eqns; ++e)
+              if (opts::isset(ct_params_t::delayed_step, opts::bit(e)) == delayed) order.push_back(e);
+
+          for (std::size_t k = 0; k < order.size(); ++k)
+          {
+            const int e = order[k];
+            const bool same_group = k + 1 < order.size() &&
+              opts::isset(ct_params_t::delayed_step, opts::bit(e)) == opts::isset(ct_params_t::delayed_step, opts::bit(order[k + 1]));
+            eqn_scratch[e] = k % mem->n_scratch;
+            eqn_barrier[e] = !is_last_eqn(e) && !(mem->n_scratch > 1 && same_group);
+          }
+        }
+
+        // selects the set of scratch arrays used by advop(), overridden by solvers that use them
+        virtual void scratch_set(const int s)
+        {
+          assert(s == 0);
+        }
+
         void solve_loop_body(const int e)
         {
           scale(e, ct_params_t::hint_scale(e));
-          xchng(e);
+          if (mem->n_scratch > 1) scratch_set(eqn_scratch[e]);
+          if (!mem->xchng_overlap) xchng(e); // otherwise done within advop()
           advop(e);
-          if(!is_last_eqn(e))
+          if (eqn_barrier[e])
             mem->barrier();
           cycle(e);  // note: assuming ascending order, mem->cycle is done after the lest eqn
           scale(e, -ct_params_t::hint_scale(e));
         }
 
+        // range r in dimension d extended only at the edges of the domain
+        template <class n_t>
+        rng_t extend_range_at_edges(const int d, const rng_t &r, const n_t n) const
+        {
+          return rng_t(
+            ijk[d].first() == mem->grid_size[d].first() ? (r - n).first() : r.first(),
+            ijk[d].last()  == mem->grid_size[d].last()  ? (r + n).last()  : r.last()
+          );
+        }
+
         // thread-aware range extension, messes range guessing in remote_3d bcond
         template <class n_t>
         rng_t extend_range(const rng_t &r, const n_t n) const
         {
-          if (mem->size == 1) return r^n;
-          return rank == 0 ? rng_t((r - n).first(), r.last()) :
-                               rank == mem->size - 1 ? rng_t(r.first(), (r + n).last()) :
-                                 r;
+          return extend_range_at_edges(mem->shmem_decomp_dim, r, n);
         }
 
         // thread-aware range extension, variadic version
@@ -150,6 +297,19 @@ namespace libmpdataxx
           return extend_range(extend_range(r, n), ns...);
         }
 
+        // tile-aware range extension in shmem_tile_dim (equivalent to r^n if there are no tiles)
+        template <class n_t>
+        rng_t extend_range_tile(const rng_t &r, const n_t n) const
+        {
+          return extend_range_at_edges(mem->shmem_tile_dim, r, n);
+        }
+
+        template <class n_t, class... ns_t>
+        rng_t extend_range_tile(const rng_t &r, const n_t n, const ns_t... ns) const
+        {
+          return extend_range_tile(extend_range_tile(r, n), ns...);
+        }
+
         private:
 
 #if !defined(NDEBUG)
@@ -211,11 +371,26 @@ namespace libmpdataxx
         public:
 
         const real_t time_() const { return time;}
+        const int rank_() const { return rank;}
 
         struct rt_params_t
         {
           std::array<int, n_dims> grid_size;
           real_t dt=0, max_abs_div_eps = blitz::epsilon(real_t(44)), max_courant = real_t(0.5);
+
+          // shared-memory concurrency settings (ignored by backends they do not apply to)
+          bool thread_pool = false; // cxx11_thread & boost_thread: keep worker threads alive between advance() calls
+          int barrier_spin = 0;     // cxx11_thread & boost_thread: if > 0, use a spin-then-block barrier spinning that many times before sleeping
+          bool nbr_sync = false;    // synchronise halo exchanges with neighbouring subdomains only (where bconds allow)
+          concurr::numa_alloc_t numa_alloc = concurr::numa_default; // placement of shared arrays on NUMA nodes
+          std::string affinity = "";  // threaded backends: pin threads to CPUs, "compact", "scatter" or an OMP_PLACES-style list, e.g. "{0:4},{4:4}"
+          int rebalance = 0;          // if > 0, shift slab boundaries between threads every that many time steps to even out measured compute time
+          bool eqn_overlap = false;   // advect consecutive equations without barriers in between (doubles the MPDATA scratch arrays)
+          int mpi_decomp_dims = 1;    // MPI: number of leading dimensions in which processes are arranged (1: x slabs, 2: x-y blocks in 2D / pencils in 3D)
+          bool mpi_overlap = false;   // MPI, 3D with x slabs: overlap the exchange of advectee x halos with computing MPDATA fluxes away from them
+          bool mpi_shm = false;       // MPI: allocate arrays in memory shared within the node and copy halos directly between them instead of sending messages
+          bool mpi_batch = true;      // MPI: send the halos of all the arrays exchanged together with a neighbour in one message (false: a message per array)
+          bool halo_skip = false;     // skip exchanges of advectee halos not written to since the last one (see solver_common::halo_valid)
         };
 
         // ctor
@@ -235,7 +410,9 @@ namespace libmpdataxx
           max_courant(p.max_courant),
           n(n_eqns, 0),
           mem(mem),
-          ijk(ijk)
+          ijk(ijk),
+          halo_skip(p.halo_skip),
+          mpi_batch(p.mpi_batch)
         {
           // compile-time sanity checks
           static_assert(n_eqns > 0, "!");
@@ -244,6 +421,8 @@ namespace libmpdataxx
           for (int d = 0; d < n_dims; ++d)
             if (p.grid_size[d] < 1)
               throw std::runtime_error("libmpdata++: bogus grid size");
+
+          schedule_eqns();
         }
 
         // dtor
@@ -265,12 +444,23 @@ namespace libmpdataxx
 #endif
         }
 
+        // moves the subdomain of the thread, to be called by concurr between solve() calls only;
+        // overridden by solvers that keep other per-thread ranges (calling the parent's version first)
+        virtual void set_subdomain(const idx_t<n_dims> &ijk_new)
+        {
+          ijk = ijk_new;
+          halo_valid.clear(); // the halos filled by this thread may have changed
+        }
+
         virtual void solve(advance_arg_t nt) final
         {
           // multiple calls to sovlve() are meant to advance the solution by nt
           // TODO: does it really work with var_dt ? we do not advance by time exactly ...
           nt += ct_params_t::var_dt ? time : timestep;
 
+          // advectees might have been modified from outside since the last call
+          halo_valid.clear();
+
           // being generous about out-of-loop barriers
           if (timestep == 0)
           {
@@ -304,6 +494,8 @@ namespace libmpdataxx
             // for variable in time velocity calculate advector at n+1/2, returns false if
             // velocity does not change in time
             bool var_gc = calc_gc();
+            if (var_gc && time_block > 1)
+              throw std::runtime_error("libmpdata++: time_block requires an advector constant in time (calc_gc() returning false)");
 
             // for variable in time velocity with adaptive time-stepping modify advector
             // to keep the Courant number roughly constant
@@ -326,6 +518,9 @@ namespace libmpdataxx
             // for third-order MPDATA we need to calculate time derivatives of the advector field
             if (var_gc && div3_mpdata) calc_ndt_gc();
 
+            if (!ct_params_t::var_dt)
+              block_steps = std::min<long long int>(time_block - timestep % time_block, nt - timestep);
+
             hook_ante_step();
 
             for (int e = 0; e < n_eqns; ++e)
@@ -342,7 +537,7 @@ namespace libmpdataxx
               solve_loop_body(e);
             }
 
-            timestep++;
+            timestep += block_steps;
             time = ct_params_t::var_dt ? time + dt : timestep * dt;
             if (div3_mpdata) dt_stash[1] = dt_stash[0];
             dt_stash[0] = dt;
@@ -360,7 +555,15 @@ namespace libmpdataxx
         // psi[n] getter - just to shorten the code
         // note that e.g. in hook_post_loop it points rather to
         // psi^{n+1} than psi^{n} (hence not using the name psi_n)
+        // (assumed to be used for writing, hence invalidates the halo)
         virtual arr_t &state(const int &e) final
+        {
+          invalidate_halo(mem->psi[e][n[e]]);
+          return mem->psi[e][n[e]];
+        }
+
+        // read-only psi[n] getter, keeps the halo valid
+        const arr_t &cstate(const int &e) const
         {
           return mem->psi[e][n[e]];
         }
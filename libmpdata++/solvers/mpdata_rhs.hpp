@@ -71,7 +71,7 @@ namespace libmpdataxx
         }
 
         // fill halos with data (e.g. for computing gradients)
-        for (int e = 0; e < parent_t::n_eqns; ++e) this->xchng(e);
+        this->xchng_eqns();
       }
 
       virtual void apply_rhs(
@@ -99,6 +99,8 @@ namespace libmpdataxx
         rhs(args.mem->tmp[__FILE__][0])
       {
         assert(this->dt != 0);
+        if (p.time_block > 1)
+          throw std::runtime_error("libmpdata++: time_block cannot be used with right-hand-side terms");
       }
 
       // dtor
@@ -34,7 +34,7 @@ namespace libmpdataxx
       using parent_t = detail::mpdata_rhs_vip_common<ct_params_t, minhalo>;
 
       // member fields
-      const rng_t im;
+      rng_t im;
 
       void interpolate_in_space(arrvec_t<typename parent_t::arr_t> &dst,
                                 const arrvec_t<typename parent_t::arr_t> &src) final
@@ -64,6 +64,12 @@ namespace libmpdataxx
 
       public:
 
+      void set_subdomain(const idx_t<parent_t::n_dims> &ijk_new) override
+      {
+        parent_t::set_subdomain(ijk_new);
+        im = rng_t(this->ijk[0].first() - 1, this->ijk[0].last());
+      }
+
       // ctor
       mpdata_rhs_vip(
         typename parent_t::ctor_args_t args,
@@ -93,7 +99,7 @@ namespace libmpdataxx
       using parent_t = detail::mpdata_rhs_vip_common<ct_params_t, minhalo>;
 
       // member fields
-      const rng_t im, jm;
+      rng_t im, jm;
 
       template<int d, class arr_t>
       void intrp(
@@ -150,6 +156,13 @@ namespace libmpdataxx
 
       public:
 
+      void set_subdomain(const idx_t<parent_t::n_dims> &ijk_new) override
+      {
+        parent_t::set_subdomain(ijk_new);
+        im = rng_t(this->ijk[0].first() - 1, this->ijk[0].last());
+        jm = rng_t(this->ijk[1].first() - 1, this->ijk[1].last());
+      }
+
       // ctor
       mpdata_rhs_vip(
         typename parent_t::ctor_args_t args,
@@ -203,7 +216,7 @@ namespace libmpdataxx
       using parent_t = detail::mpdata_rhs_vip_common<ct_params_t, minhalo>;
 
       // member fields
-      const rng_t im, jm, km;
+      rng_t im, jm, km;
 
       template<int d, class arr_t>
       void intrp(
@@ -289,6 +302,14 @@ namespace libmpdataxx
         }
       }
 
+      void set_subdomain(const idx_t<parent_t::n_dims> &ijk_new) override
+      {
+        parent_t::set_subdomain(ijk_new);
+        im = rng_t(this->ijk[0].first() - 1, this->ijk[0].last());
+        jm = rng_t(this->ijk[1].first() - 1, this->ijk[1].last());
+        km = rng_t(this->ijk[2].first() - 1, this->ijk[2].last());
+      }
+
       // ctor
       mpdata_rhs_vip(
         typename parent_t::ctor_args_t args,
@@ -76,13 +76,13 @@ namespace libmpdataxx
         void hook_post_step()
         {
           parent_t::hook_post_step();
-          assert(min(this->state(ct_params_t::ix::h)(this->ijk)) >= 0);
+          assert(min(this->cstate(ct_params_t::ix::h)(this->ijk)) >= 0);
         }
 
         void hook_ante_step()
         {
           parent_t::hook_ante_step();
-          assert(min(this->state(ct_params_t::ix::h)(this->ijk)) >= 0);
+          assert(min(this->cstate(ct_params_t::ix::h)(this->ijk)) >= 0);
         }
 
         public:
@@ -129,8 +129,8 @@ namespace libmpdataxx
 
         rhs.at(ix::qx)(this->i) -=
           this->g
-          * this->state(ix::h)(this->i)
-          * grad(this->state(ix::h), this->i, this->di);
+          * this->cstate(ix::h)(this->i)
+          * grad(this->cstate(ix::h), this->i, this->di);
       }
     };
 
@@ -155,7 +155,7 @@ namespace libmpdataxx
       )
       {
         using namespace libmpdataxx::formulae::nabla;
-        rhs(pi<d>(i,j)) -= this->g * this->state(ix::h)(pi<d>(i,j)) * grad<d>(this->state(ix::h), i, j, di);
+        rhs(pi<d>(i,j)) -= this->g * this->cstate(ix::h)(pi<d>(i,j)) * grad<d>(this->cstate(ix::h), i, j, di);
       }
 
       /// @brief Shallow Water Equations: Momentum forcings for the X and Y coordinates
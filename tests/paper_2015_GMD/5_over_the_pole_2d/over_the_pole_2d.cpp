@@ -70,6 +70,7 @@ void test(const std::string filename)
 
   decltype(run.advectee()) 
     tmp(run.advectee().extent());
+  tmp.reindexSelf(run.advectee().base()); // global indices with MPI
 
   tmp = 2 * (  blitz::pow2(blitz::cos(dphi * (j + 0.5) - pi / 2) * blitz::sin((dlmb * i - x0) / 2))
              + blitz::pow2(blitz::sin((dphi * (j + 0.5) - pi / 2 - y0) / 2))                     );
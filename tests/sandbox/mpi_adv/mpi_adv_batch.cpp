@@ -0,0 +1,118 @@
+/*
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * FCT-MPDATA with three iterations (exchanging the advectee, the antidiffusive
+ * velocities along and normal to the process edges and the fluxes) with the halos
+ * of the arrays exchanged together with a neighbour sent in one message vs. a message
+ * per array, and over several advance() calls (reusing the persistent requests set up
+ * in the first one) vs. a single call (results expected to be bitwise identical)
+ */
+
+#include <stdexcept>
+#include <string>
+#include <libmpdata++/solvers/mpdata.hpp>
+#include <libmpdata++/concurr/threads.hpp>
+
+using T = double;
+using namespace libmpdataxx;
+
+template <int n_dims_arg>
+struct ct_params_t : ct_params_default_t
+{
+  using real_t = T;
+  enum { n_dims = n_dims_arg };
+  enum { n_eqns = 2 };
+  enum { opts = opts::fct | opts::abs };
+};
+
+const int nt = 20;
+
+blitz::Array<T, 2> run_2d(const int mpi_decomp_dims, const bool mpi_batch, const int n_calls)
+{
+  using slv_t = solvers::mpdata<ct_params_t<2>>;
+  typename slv_t::rt_params_t p;
+  p.grid_size = {36, 28};
+  p.n_iters = 3;
+  p.mpi_decomp_dims = mpi_decomp_dims;
+  p.mpi_batch = mpi_batch;
+
+  concurr::threads<
+    slv_t,
+    bcond::cyclic, bcond::cyclic,
+    bcond::cyclic, bcond::cyclic
+  > run(p);
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+
+  run.advectee_init(exp(-(pow(i - 12., 2) + pow(j - 10., 2)) / 20.) - .5, 0);
+  run.advectee_init(where(abs(i - 18.) < 6 && abs(j - 14.) < 5, 1., 0.), 1);
+
+  run.advector(0) = .3;
+  run.advector(1) = -.2;
+
+  for (int c = 0; c < n_calls; ++c) run.advance(nt / n_calls);
+
+  blitz::Array<T, 2> ret(2 * p.grid_size[0], p.grid_size[1]);
+  for (int e = 0; e < 2; ++e)
+    ret(blitz::Range(e * p.grid_size[0], (e + 1) * p.grid_size[0] - 1), blitz::Range::all()) = run.advectee_global(e);
+  return ret;
+}
+
+blitz::Array<T, 3> run_3d(const int mpi_decomp_dims, const bool mpi_batch, const int n_calls)
+{
+  using slv_t = solvers::mpdata<ct_params_t<3>>;
+  typename slv_t::rt_params_t p;
+  p.grid_size = {24, 20, 12};
+  p.n_iters = 3;
+  p.mpi_decomp_dims = mpi_decomp_dims;
+  p.mpi_batch = mpi_batch;
+
+  concurr::threads<
+    slv_t,
+    bcond::cyclic, bcond::cyclic,
+    bcond::cyclic, bcond::cyclic,
+    bcond::cyclic, bcond::cyclic
+  > run(p);
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+  blitz::thirdIndex k;
+
+  run.advectee_init(exp(-(pow(i - 8., 2) + pow(j - 6., 2) + pow(k - 6., 2)) / 10.) - .5, 0);
+  run.advectee_init(where(abs(i - 14.) < 4 && abs(j - 10.) < 4 && abs(k - 6.) < 3, 1., 0.), 1);
+
+  run.advector(0) = .3;
+  run.advector(1) = -.2;
+  run.advector(2) = .1;
+
+  for (int c = 0; c < n_calls; ++c) run.advance(nt / n_calls);
+
+  blitz::Array<T, 3> ret(2 * p.grid_size[0], p.grid_size[1], p.grid_size[2]);
+  for (int e = 0; e < 2; ++e)
+    ret(blitz::Range(e * p.grid_size[0], (e + 1) * p.grid_size[0] - 1), blitz::Range::all(), blitz::Range::all()) = run.advectee_global(e);
+  return ret;
+}
+
+template <class run_t>
+void test(const int n_dims, run_t run)
+{
+  for (const int mpi_decomp_dims : {1, 2})
+  {
+    const std::string cfg = std::to_string(n_dims) + "D, mpi_decomp_dims=" + std::to_string(mpi_decomp_dims);
+    const auto batched = run(mpi_decomp_dims, true, 4);
+    if (!all(batched == run(mpi_decomp_dims, false, 4)))
+      throw std::runtime_error(cfg + ": batched exchanges changed the results");
+    if (!all(batched == run(mpi_decomp_dims, true, 1)))
+      throw std::runtime_error(cfg + ": results of several advance() calls differ from those of one");
+  }
+}
+
+int main()
+{
+  test(2, run_2d);
+  test(3, run_3d);
+}
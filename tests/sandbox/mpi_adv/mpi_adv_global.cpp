@@ -0,0 +1,119 @@
+/*
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * distributed initialisation with functions of global indices or expressions,
+ * and root-only gathering, slices and chunks of a distributed advectee
+ * compared against advectee_global(), itself checked on every process
+ */
+
+#include <libmpdata++/solvers/mpdata.hpp>
+#include <libmpdata++/concurr/threads.hpp>
+
+using T = double;
+using namespace libmpdataxx;
+
+template <int n_dims_arg>
+struct ct_params_t : ct_params_default_t
+{
+  using real_t = T;
+  enum { n_dims = n_dims_arg };
+  enum { n_eqns = 1 };
+};
+
+template <int n_dims>
+bool same(const blitz::Array<T, n_dims> &a, const blitz::Array<T, n_dims> &b)
+{
+  return all(a.lbound() == b.lbound()) && all(a.shape() == b.shape()) && all(a == b);
+}
+
+void check(const bool cond, const std::string &what)
+{
+  if (!cond) throw std::runtime_error("advectee_global_" + what + "() differs from advectee_global()");
+}
+
+// x slabs: advectee_global() and slices with the default root (i.e. on all processes)
+void test_2d()
+{
+  using slv_t = solvers::mpdata<ct_params_t<2>>;
+  typename slv_t::rt_params_t p;
+  p.grid_size = {13, 7};
+
+  concurr::threads<slv_t, bcond::cyclic, bcond::cyclic, bcond::cyclic, bcond::cyclic> run(p);
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+
+  blitz::Array<T, 2> init(p.grid_size[0], p.grid_size[1]);
+  init = 10 * i + j;
+  run.advectee_init([](const blitz::TinyVector<int, 2> &ij) { return 10. * ij[0] + ij[1]; });
+
+  check(same(run.advectee_global().copy(), init), "");
+
+  const idx_t<2> box({rng_t(2, 11), rng_t(1, 5)});
+  check(same(run.advectee_global_slice(box), init(box).reindex(box.lbound())), "slice");
+}
+
+// x-y pencils
+void test_3d()
+{
+  using slv_t = solvers::mpdata<ct_params_t<3>>;
+  typename slv_t::rt_params_t p;
+  p.grid_size = {12, 10, 8};
+  p.mpi_decomp_dims = 2;
+
+  concurr::threads<
+    slv_t,
+    bcond::cyclic, bcond::cyclic,
+    bcond::cyclic, bcond::cyclic,
+    bcond::cyclic, bcond::cyclic
+  > run(p);
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+  blitz::thirdIndex k;
+
+  blitz::Array<T, 3> init(p.grid_size[0], p.grid_size[1], p.grid_size[2]);
+  init = 100 * i + 10 * j + k;
+  // each process and thread evaluating the function over its part only
+  run.advectee_init([](const blitz::TinyVector<int, 3> &ijk) { return 100. * ijk[0] + 10. * ijk[1] + ijk[2]; });
+
+  const blitz::Array<T, 3> global = run.advectee_global().copy();
+  check(same(global, init), "");
+
+  // an expression of index placeholders, indices of the advector as returned by advector()
+  run.advector_init(10. * j, 1);
+  if (!all(run.advector(1) == 10. * j)) throw std::runtime_error("advector_init() failed");
+
+  // whole domain on rank 0 only
+  const auto gathered = run.advectee_global_gather();
+  const bool root = gathered.numElements() > 0;
+  if (root) check(same(gathered, init), "gather");
+
+  // a sub-box crossing process boundaries and a single y-plane
+  for (const auto &box : {
+    idx_t<3>({rng_t(3, 9), rng_t(2, 7), rng_t(1, 6)}),
+    idx_t<3>({rng_t(0, 11), rng_t(4, 4), rng_t(0, 7)})
+  })
+  {
+    const auto slice = run.advectee_global_slice(box);
+    check(same(slice, init(box).reindex(box.lbound())), "slice");
+  }
+
+  // chunks of 5 x-planes (the last one shorter)
+  int n_planes = 0;
+  run.advectee_global_chunks([&](const blitz::Array<T, 3> &chunk) {
+    const idx_t<3> box({rng_t(chunk.lbound(0), chunk.ubound(0)), rng_t(0, 9), rng_t(0, 7)});
+    check(same(chunk, init(box).reindex(box.lbound())), "chunks");
+    n_planes += chunk.extent(0);
+  }, 0, 5);
+  if (root) check(n_planes == p.grid_size[0], "chunks");
+}
+
+int main()
+{
+  test_2d();
+  test_3d();
+}
@@ -0,0 +1,122 @@
+/*
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * diagonal advection with MPI processes arranged in x and y
+ * (2D blocks and 3D pencils) and with x halo exchanges overlapped
+ * with computations (3D) or through shared memory between processes on the same node
+ * compared against the default x-slab decomposition; built also with one-sided
+ * halo exchanges (LIBMPDATAXX_MPI_RMA) to compare the timings
+ */
+
+#include <chrono>
+#include <cmath>
+#include <tuple>
+#include <libmpdata++/solvers/mpdata.hpp>
+#include <libmpdata++/concurr/threads.hpp>
+
+using T = double;
+using namespace libmpdataxx;
+
+template <int n_dims_arg>
+struct ct_params_t : ct_params_default_t
+{
+  using real_t = T;
+  enum { n_dims = n_dims_arg };
+  enum { n_eqns = 1 };
+};
+
+blitz::Array<T, 2> run_2d(const int mpi_decomp_dims, const bool mpi_overlap, const bool mpi_shm, const int nt)
+{
+  using slv_t = solvers::mpdata<ct_params_t<2>>;
+  typename slv_t::rt_params_t p;
+  p.grid_size = {48, 40};
+  p.mpi_decomp_dims = mpi_decomp_dims;
+  p.mpi_overlap = mpi_overlap;
+  p.mpi_shm = mpi_shm;
+
+  concurr::threads<
+    slv_t,
+    bcond::cyclic, bcond::cyclic,
+    bcond::cyclic, bcond::cyclic
+  > run(p);
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+
+  blitz::Array<T, 2> init(p.grid_size[0], p.grid_size[1]);
+  init = exp(-(pow(i - 12., 2) + pow(j - 10., 2)) / 20.);
+  run.advectee_global_set(init);
+
+  run.advector(0) = .3;
+  run.advector(1) = .2;
+
+  run.advance(nt);
+  return run.advectee_global().copy();
+}
+
+blitz::Array<T, 3> run_3d(const int mpi_decomp_dims, const bool mpi_overlap, const bool mpi_shm, const int nt)
+{
+  using slv_t = solvers::mpdata<ct_params_t<3>>;
+  typename slv_t::rt_params_t p;
+  p.grid_size = {32, 24, 16};
+  p.mpi_decomp_dims = mpi_decomp_dims;
+  p.mpi_overlap = mpi_overlap;
+  p.mpi_shm = mpi_shm;
+
+  concurr::threads<
+    slv_t,
+    bcond::cyclic, bcond::cyclic,
+    bcond::cyclic, bcond::cyclic,
+    bcond::cyclic, bcond::cyclic
+  > run(p);
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+  blitz::thirdIndex k;
+
+  blitz::Array<T, 3> init(p.grid_size[0], p.grid_size[1], p.grid_size[2]);
+  init = exp(-(pow(i - 8., 2) + pow(j - 6., 2) + pow(k - 8., 2)) / 10.);
+  run.advectee_global_set(init);
+
+  run.advector(0) = .3;
+  run.advector(1) = .2;
+  run.advector(2) = .1;
+
+  run.advance(nt);
+  return run.advectee_global().copy();
+}
+
+template <class run_t>
+void test(const int n_dims, run_t run)
+{
+  const int nt = 20;
+  const auto slabs = run(1, false, false, nt);
+
+#if defined(LIBMPDATAXX_MPI_RMA)
+  const char *xchng = "one-sided";
+#else
+  const char *xchng = "two-sided";
+#endif
+
+  for (const auto &cfg : {std::make_tuple(2, false, false), std::make_tuple(1, true, false), std::make_tuple(2, false, true)})
+  {
+    const auto t0 = std::chrono::steady_clock::now();
+    const auto res = run(std::get<0>(cfg), std::get<1>(cfg), std::get<2>(cfg), nt);
+    const std::chrono::duration<double> time = std::chrono::steady_clock::now() - t0;
+
+    const T diff = max(abs(res - slabs));
+    std::cout << n_dims << "D " << xchng << " mpi_decomp_dims=" << std::get<0>(cfg) << " mpi_overlap=" << std::get<1>(cfg) << " mpi_shm=" << std::get<2>(cfg)
+      << " time: " << time.count() << "s max difference: " << diff << std::endl;
+    if (!(diff < 1e-12))
+      throw std::runtime_error("results differ from those with x slabs");
+  }
+}
+
+int main()
+{
+  test(2, run_2d);
+  test(3, run_3d);
+}
@@ -0,0 +1,53 @@
+/* 
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * parsing of thread affinity policies
+ */
+
+#include <libmpdata++/concurr/detail/affinity.hpp>
+
+#include <iostream>
+
+using namespace libmpdataxx::concurr::detail;
+
+void check(const std::string &policy, const int rank, const std::vector<int> &expected)
+{
+  if (affinity(policy).place(rank) != expected)
+    throw std::runtime_error("unexpected place for policy: " + policy);
+}
+
+int main()
+{
+  if (affinity("").enabled()) throw std::runtime_error("empty policy should not pin");
+
+  check("{0,1},{2,3}", 1, {2, 3});
+  check("{0,1},{2,3}", 2, {0, 1});
+  check("{0:4}:4:4", 3, {12, 13, 14, 15});
+  check("{0:2:2}", 0, {0, 2});
+  check("0,2,4,6", 2, {4});
+  check("0:3", 1, {1});
+
+  for (const std::string policy : {"{0", "{0}x", "a,b", "{0}:1:2:3"})
+  {
+    try
+    {
+      affinity a(policy);
+    }
+    catch (const std::runtime_error &)
+    {
+      continue;
+    }
+    throw std::runtime_error("invalid policy accepted: " + policy);
+  }
+
+  // compact and scatter over the CPUs available to the process
+  for (const std::string policy : {"compact", "scatter"})
+  {
+    affinity a(policy);
+    a.print(4);
+    a.pin(0);
+  }
+}
@@ -0,0 +1,52 @@
+/* 
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * barrier latency vs. number of threads for the mutex/condvar barrier
+ * used by cxx11_thread, boost::barrier and the spin-then-block barrier
+ */
+
+#include <libmpdata++/concurr/cxx11_thread.hpp>
+#include <libmpdata++/concurr/detail/spin_barrier.hpp>
+
+#include <boost/thread/barrier.hpp>
+
+#include <chrono>
+#include <iostream>
+
+const int n_rounds = 20000;
+
+template <class barrier_t>
+double test(barrier_t &b, const int nthreads)
+{
+  std::vector<std::thread> threads;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < nthreads; ++i)
+    threads.emplace_back([&b]() { for (int r = 0; r < n_rounds; ++r) b.wait(); });
+  for (auto &th : threads) th.join();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / n_rounds;
+}
+
+int main()
+{
+  using namespace libmpdataxx::concurr::detail;
+
+  const int max_threads = std::max(2u, std::thread::hardware_concurrency());
+
+  std::cout << "# nthreads  condvar[ns]  boost::barrier[ns]  spin_barrier[ns]" << std::endl;
+  for (int n = 1; n <= max_threads; n *= 2)
+  {
+    barrier b_cv(n);
+    boost::barrier b_boost(n);
+    spin_barrier b_spin(n, 4096);
+
+    std::cout 
+      << n << "  " 
+      << test(b_cv, n) << "  "
+      << test(b_boost, n) << "  " 
+      << test(b_spin, n) << std::endl;
+  }
+}
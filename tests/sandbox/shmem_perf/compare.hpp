@@ -0,0 +1,125 @@
+/*
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * common code of the shmem_perf tests comparing runs that differ only in how
+ * the work is scheduled: advancing a solver with the wall time measured, counting
+ * the barriers passed, and checking that the advectees of all the runs are bitwise identical
+ */
+
+#pragma once
+
+#include <libmpdata++/blitz.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace shmem_perf
+{
+  // barrier() and barrier_nbr() calls made within the time steps of a solver wrapped in counted<>
+  // by all its threads since the last reset(), the number of the threads and whether concurr
+  // enabled neighbour-only synchronisation
+  struct barrier_counts_t
+  {
+    std::atomic<unsigned long long> full{0}, nbr{0};
+    std::atomic<int> threads{0};
+    std::atomic<bool> nbr_sync{false};
+
+    void reset()
+    {
+      full = 0;
+      nbr = 0;
+    }
+  };
+
+  inline barrier_counts_t &barrier_counts()
+  {
+    static barrier_counts_t counts;
+    return counts;
+  }
+
+  template <class slv_t>
+  struct counted : slv_t
+  {
+    using slv_t::slv_t;
+    using mem_t = typename slv_t::mem_t;
+
+    unsigned long long full0, nbr0;
+
+    void hook_ante_step()
+    {
+      barrier_counts().threads = this->mem->size;
+      barrier_counts().nbr_sync = this->mem->nbr_sync;
+      full0 = mem_t::barrier_calls();
+      nbr0 = mem_t::barrier_nbr_calls();
+      slv_t::hook_ante_step();
+    }
+
+    void hook_post_step()
+    {
+      slv_t::hook_post_step();
+      barrier_counts().full += mem_t::barrier_calls() - full0;
+      barrier_counts().nbr += mem_t::barrier_nbr_calls() - nbr0;
+    }
+  };
+
+  template <int n_dims>
+  struct outcome_t
+  {
+    double time; // wall time of the advance() calls [s]
+    std::vector<blitz::Array<double, n_dims>> advectees;
+  };
+
+  // advances run by nt time steps in calls of advance() for steps_per_call steps each (all at once by default),
+  // and copies the advectees of n_eqns equations as held by this process (i.e. its part of the domain with MPI)
+  template <int n_dims, class run_t>
+  outcome_t<n_dims> advance(run_t &run, const int nt, const int n_eqns = 1, int steps_per_call = 0)
+  {
+    if (steps_per_call == 0) steps_per_call = nt;
+
+    outcome_t<n_dims> ret;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int t = 0; t < nt; t += steps_per_call) run.advance(std::min(steps_per_call, nt - t));
+    auto t1 = std::chrono::steady_clock::now();
+    ret.time = std::chrono::duration<double>(t1 - t0).count();
+
+    for (int e = 0; e < n_eqns; ++e)
+    {
+      ret.advectees.emplace_back(run.advectee(e).shape());
+      ret.advectees.back() = run.advectee(e);
+    }
+    return ret;
+  }
+
+  // prints the wall times of the labelled runs and throws if the advectees of any of them
+  // differ from those of the first one
+  template <int n_dims>
+  void compare(const std::string &name, const std::vector<std::pair<std::string, outcome_t<n_dims>>> &runs)
+  {
+    std::cout << name << ":";
+    for (const auto &run : runs)
+      std::cout << (&run == &runs.front() ? " " : ", ") << run.first << ": " << run.second.time << " s";
+    std::cout << std::endl;
+
+    const auto &ref = runs.front();
+    for (const auto &run : runs)
+    {
+      if (run.second.advectees.size() != ref.second.advectees.size())
+        throw std::runtime_error(name + ": different numbers of equations");
+      for (std::size_t e = 0; e < ref.second.advectees.size(); ++e)
+      {
+        const auto &a = run.second.advectees[e], &b = ref.second.advectees[e];
+        if (any(a.shape() != b.shape()) || any(a != b))
+          throw std::runtime_error(name + ": results differ between " + ref.first + " and " + run.first);
+      }
+    }
+  }
+} // namespace shmem_perf
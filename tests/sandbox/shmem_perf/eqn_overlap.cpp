@@ -0,0 +1,85 @@
+/* 
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * wall time of a 3D run with several passive tracers advected
+ * with barriers between equations vs. with consecutive equations
+ * using separate scratch arrays and no barriers in between
+ * (results are expected to be bitwise identical, and the barriers between
+ * equations of the same group, i.e. all but the one before the delayed ones, to be gone)
+ */
+
+#include <libmpdata++/solvers/mpdata.hpp>
+#include <libmpdata++/concurr/threads.hpp>
+
+#include "compare.hpp"
+
+using namespace libmpdataxx;
+
+struct ct_params_t : ct_params_default_t
+{
+  using real_t = double;
+  enum { n_dims = 3 };
+  enum { n_eqns = 5 };
+  enum { opts = opts::fct };
+  enum { delayed_step = opts::bit(3) | opts::bit(4) };
+};
+
+const int nx = 32, ny = 32, nz = 32, nt = 20;
+
+shmem_perf::outcome_t<3> test(const bool eqn_overlap, const bool nbr_sync)
+{
+  using slv_t = shmem_perf::counted<solvers::mpdata<ct_params_t>>;
+
+  typename slv_t::rt_params_t p;
+  p.grid_size = {nx, ny, nz};
+  p.n_iters = 3;
+  p.eqn_overlap = eqn_overlap;
+  p.nbr_sync = nbr_sync;
+
+  concurr::threads<
+    slv_t, 
+    bcond::cyclic, bcond::cyclic,
+    bcond::cyclic, bcond::cyclic,
+    bcond::open, bcond::open
+  > run(p);
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+  blitz::thirdIndex k;
+  for (int e = 0; e < ct_params_t::n_eqns; ++e)
+    run.advectee(e) = exp(-(pow(i - nx / 2., 2) + pow(j - ny / 2., 2) + pow(k - nz / 2., 2)) / (10. + 5 * e));
+  run.advector(0) = .3;
+  run.advector(1) = -.2;
+  run.advector(2) = .1;
+
+  shmem_perf::barrier_counts().reset();
+  return shmem_perf::advance<3>(run, nt, ct_params_t::n_eqns);
+}
+
+int main()
+{
+  auto &counts = shmem_perf::barrier_counts();
+
+  // 5 equations in two groups (non-delayed and delayed ones)
+  const unsigned long long n_skipped = ct_params_t::n_eqns - 2;
+
+  for (const bool nbr_sync : {false, true})
+  {
+    const auto sep = test(false, nbr_sync);
+    const unsigned long long full_barriers = counts.full, nbr_barriers = counts.nbr;
+
+    const auto ovl = test(true, nbr_sync);
+    std::cout << "full barriers per thread and step: " << double(full_barriers) / counts.threads / nt << " vs. "
+      << double(counts.full) / counts.threads / nt << std::endl;
+    if (full_barriers - counts.full != n_skipped * counts.threads * nt || counts.nbr != nbr_barriers)
+      throw std::runtime_error("eqn_overlap did not remove exactly the barriers between equations of the same group");
+
+    shmem_perf::compare<3>(nbr_sync ? "neighbour-only sync" : "full barriers", {
+      {"barriers between equations", sep},
+      {"overlapping equations",      ovl}
+    });
+  }
+}
@@ -0,0 +1,161 @@
+/*
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * cells per second of the 2D and 3D FCT bounds and betas computed by
+ * psi_min_max() and beta() in loops (fct_beta) or in explicitly vectorised
+ * loops (fct_beta_simd built with LIBMPDATAXX_SIMD) vs. by Blitz++ expressions
+ * (the results compared with those of the latter)
+ */
+
+#include <libmpdata++/formulae/mpdata/formulae_mpdata_fct_2d.hpp>
+#include <libmpdata++/formulae/mpdata/formulae_mpdata_fct_3d.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace libmpdataxx;
+using namespace libmpdataxx::arakawa_c;
+
+const int n_rep = 20;
+
+#if defined(LIBMPDATAXX_SIMD)
+const std::string kernel = "explicitly vectorised loops";
+#else
+const std::string kernel = "loops";
+#endif
+
+template <class arr_t>
+double rel_diff(const arr_t &a, const arr_t &b)
+{
+  return max(abs(a - b)) / max(abs(b));
+}
+
+template <opts::opts_t opts>
+void test_2d(const std::string &name, const int nx, const int ny)
+{
+  using arr_t = blitz::Array<double, 2>;
+  const rng_t i(0, nx - 1), j(0, ny - 1), ha(-2, nx + 1), hb(-2, ny + 1);
+  blitz::firstIndex ii;
+  blitz::secondIndex jj;
+
+  arr_t psi(ha, hb), psi_min(ha, hb), psi_max(ha, hb), G(ha, hb), b_up(ha, hb), b_dn(ha, hb), b_up_ref(ha, hb), b_dn_ref(ha, hb);
+  arrvec_t<arr_t> flx;
+  for (int d = 0; d < 2; ++d) flx.push_back(new arr_t(ha, hb));
+
+  psi = 1 + sin(ii * .3) * cos(jj * .2);
+  G = exp(.1 * (cos(ii * .3) + cos(jj * .2)));
+  flx[0] = .3 * cos(ii * .1 + jj * .4);
+  flx[1] = -.2 * sin(ii * .2 - jj * .3);
+
+  const auto kernels = [&] {
+    formulae::mpdata::psi_min_max(psi_min, psi_max, psi, i, j);
+    formulae::mpdata::beta<opts>(b_up, b_dn, psi, psi_min, psi_max, flx, G, i, j);
+  };
+  const auto expressions = [&] {
+    psi_min(i, j) = min(min(min(min(psi(i, j+1), psi(i-1, j)), psi(i, j)), psi(i+1, j)), psi(i, j-1));
+    psi_max(i, j) = max(max(max(max(psi(i, j+1), psi(i-1, j)), psi(i, j)), psi(i+1, j)), psi(i, j-1));
+    b_up_ref(i, j) = formulae::mpdata::fct_frac<rng_t>(
+      formulae::mpdata::beta_up_nominator<opts>(psi, psi_max, G, i, j),
+      ( formulae::pospart<opts, rng_t>(flx[0](i-h, j)) - formulae::negpart<opts, rng_t>(flx[0](i+h, j)) )
+      +
+      ( formulae::pospart<opts, rng_t>(flx[1](i, j-h)) - formulae::negpart<opts, rng_t>(flx[1](i, j+h)) )
+    );
+    b_dn_ref(i, j) = formulae::mpdata::fct_frac<rng_t>(
+      formulae::mpdata::beta_dn_nominator<opts>(psi, psi_min, G, i, j),
+      ( formulae::pospart<opts, rng_t>(flx[0](i+h, j)) - formulae::negpart<opts, rng_t>(flx[0](i-h, j)) )
+      +
+      ( formulae::pospart<opts, rng_t>(flx[1](i, j+h)) - formulae::negpart<opts, rng_t>(flx[1](i, j-h)) )
+    );
+  };
+
+  const auto cells_per_s = [&](const auto &fun) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < n_rep; ++r) fun();
+    auto t1 = std::chrono::steady_clock::now();
+    return double(n_rep) * nx * ny / std::chrono::duration<double>(t1 - t0).count();
+  };
+
+  const double c_ref = cells_per_s(expressions), c_ker = cells_per_s(kernels);
+  std::cout << name << ": Blitz++ expressions: " << c_ref << " cells/s, " << kernel << ": " << c_ker << " cells/s" << std::endl;
+
+  // not necessarily bitwise identical, e.g. due to different contractions into fused multiply-adds
+  if (rel_diff(b_up(i, j), b_up_ref(i, j)) > 1e-12 || rel_diff(b_dn(i, j), b_dn_ref(i, j)) > 1e-12)
+    throw std::runtime_error("betas differ from those computed by Blitz++ expressions: " + name);
+}
+
+template <opts::opts_t opts>
+void test_3d(const std::string &name, const int nx, const int ny, const int nz)
+{
+  using arr_t = blitz::Array<double, 3>;
+  const rng_t i(0, nx - 1), j(0, ny - 1), k(0, nz - 1), ha(-2, nx + 1), hb(-2, ny + 1), hc(-2, nz + 1);
+  blitz::firstIndex ii;
+  blitz::secondIndex jj;
+  blitz::thirdIndex kk;
+
+  // as allocated by the solvers
+  const auto arr = [&] { return new arr_t(ha, hb, hc, arr3D_storage); };
+  arrvec_t<arr_t> a, flx;
+  for (int n = 0; n < 8; ++n) a.push_back(arr());
+  for (int d = 0; d < 3; ++d) flx.push_back(arr());
+  arr_t &psi = a[0], &psi_min = a[1], &psi_max = a[2], &G = a[3], &b_up = a[4], &b_dn = a[5], &b_up_ref = a[6], &b_dn_ref = a[7];
+
+  psi = 1 + sin(ii * .3) * cos(jj * .2) * cos(kk * .4);
+  G = exp(.1 * (cos(ii * .3) + cos(jj * .2) + cos(kk * .1)));
+  flx[0] = .3 * cos(ii * .1 + jj * .4 - kk * .2);
+  flx[1] = -.2 * sin(ii * .2 - jj * .3 + kk * .1);
+  flx[2] = .1 * cos(ii * .3 + jj * .1 + kk * .5);
+
+  const auto kernels = [&] {
+    formulae::mpdata::psi_min_max(psi_min, psi_max, psi, i, j, k);
+    formulae::mpdata::beta<opts>(b_up, b_dn, psi, psi_min, psi_max, flx, G, i, j, k);
+  };
+  const auto expressions = [&] {
+    psi_min(i, j, k) = min(min(min(min(min(min(
+      psi(i, j, k), psi(i+1, j, k)), psi(i-1, j, k)), psi(i, j+1, k)), psi(i, j-1, k)), psi(i, j, k+1)), psi(i, j, k-1)
+    );
+    psi_max(i, j, k) = max(max(max(max(max(max(
+      psi(i, j, k), psi(i+1, j, k)), psi(i-1, j, k)), psi(i, j+1, k)), psi(i, j-1, k)), psi(i, j, k+1)), psi(i, j, k-1)
+    );
+    b_up_ref(i, j, k) = formulae::mpdata::fct_frac<rng_t>(
+      formulae::mpdata::beta_up_nominator<opts>(psi, psi_max, G, i, j, k),
+      ( formulae::pospart<opts, rng_t>(flx[0](i-h, j, k)) - formulae::negpart<opts, rng_t>(flx[0](i+h, j, k)) )
+      +
+      ( formulae::pospart<opts, rng_t>(flx[1](i, j-h, k)) - formulae::negpart<opts, rng_t>(flx[1](i, j+h, k)) )
+      +
+      ( formulae::pospart<opts, rng_t>(flx[2](i, j, k-h)) - formulae::negpart<opts, rng_t>(flx[2](i, j, k+h)) )
+    );
+    b_dn_ref(i, j, k) = formulae::mpdata::fct_frac<rng_t>(
+      formulae::mpdata::beta_dn_nominator<opts>(psi, psi_min, G, i, j, k),
+      ( formulae::pospart<opts, rng_t>(flx[0](i+h, j, k)) - formulae::negpart<opts, rng_t>(flx[0](i-h, j, k)) )
+      +
+      ( formulae::pospart<opts, rng_t>(flx[1](i, j+h, k)) - formulae::negpart<opts, rng_t>(flx[1](i, j-h, k)) )
+      +
+      ( formulae::pospart<opts, rng_t>(flx[2](i, j, k+h)) - formulae::negpart<opts, rng_t>(flx[2](i, j, k-h)) )
+    );
+  };
+
+  const auto cells_per_s = [&](const auto &fun) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < n_rep; ++r) fun();
+    auto t1 = std::chrono::steady_clock::now();
+    return double(n_rep) * nx * ny * nz / std::chrono::duration<double>(t1 - t0).count();
+  };
+
+  const double c_ref = cells_per_s(expressions), c_ker = cells_per_s(kernels);
+  std::cout << name << ": Blitz++ expressions: " << c_ref << " cells/s, " << kernel << ": " << c_ker << " cells/s" << std::endl;
+
+  if (rel_diff(b_up(i, j, k), b_up_ref(i, j, k)) > 1e-12 || rel_diff(b_dn(i, j, k), b_dn_ref(i, j, k)) > 1e-12)
+    throw std::runtime_error("betas differ from those computed by Blitz++ expressions: " + name);
+}
+
+int main()
+{
+  test_2d<opts::fct>("2D", 1024, 1024);
+  test_2d<opts::fct | opts::nug>("2D, nug", 1024, 1024);
+  test_3d<opts::fct>("3D", 128, 128, 64);
+  test_3d<opts::fct | opts::nug>("3D, nug", 128, 128, 64);
+}
@@ -0,0 +1,115 @@
+/*
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * wall time of 2D and 3D FCT runs with a single thread vs. with multiple
+ * ones sharing the bounds and betas computed at the subdomain edges
+ * (results are expected to be bitwise identical), and the synchronisation
+ * of the threads added by FCT (with nbr_sync expected to be neighbour-only)
+ */
+
+#include <libmpdata++/solvers/mpdata.hpp>
+#include <libmpdata++/concurr/serial.hpp>
+#include <libmpdata++/concurr/threads.hpp>
+
+#include "compare.hpp"
+
+#include <string>
+#include <type_traits>
+
+using namespace libmpdataxx;
+
+template <int n_dims_arg, opts::opts_t opts_arg>
+struct ct_params_t : ct_params_default_t
+{
+  using real_t = double;
+  enum { n_dims = n_dims_arg };
+  enum { n_eqns = 1 };
+  enum { opts = opts_arg };
+};
+
+const int nt = 20;
+
+template <bool threaded, int n_dims, opts::opts_t opts>
+shmem_perf::outcome_t<n_dims> test(const bool nbr_sync = false)
+{
+  using slv_t = shmem_perf::counted<solvers::mpdata<ct_params_t<n_dims, opts>>>;
+
+  typename slv_t::rt_params_t p;
+  p.n_iters = 3;
+  p.nbr_sync = nbr_sync;
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+  blitz::thirdIndex k;
+
+  if constexpr (n_dims == 2)
+  {
+    const int nx = 400, ny = 300;
+    p.grid_size = {nx, ny};
+    std::conditional_t<threaded,
+      concurr::threads<slv_t, bcond::cyclic, bcond::cyclic, bcond::open, bcond::open>,
+      concurr::serial< slv_t, bcond::cyclic, bcond::cyclic, bcond::open, bcond::open>
+    > run(p);
+    run.advectee() = where(pow(i - nx / 2., 2) + pow(j - ny / 2., 2) < 900, 4, 1);
+    if (opts::isset(opts, opts::nug))
+      run.g_factor() = exp(.1 * (cos(i * .3) + cos(j * .2)));
+    run.advector(0) = .3;
+    run.advector(1) = -.2;
+    shmem_perf::barrier_counts().reset();
+    return shmem_perf::advance<n_dims>(run, nt);
+  }
+  else
+  {
+    const int nx = 48, ny = 48, nz = 48;
+    p.grid_size = {nx, ny, nz};
+    std::conditional_t<threaded,
+      concurr::threads<slv_t, bcond::cyclic, bcond::cyclic, bcond::cyclic, bcond::cyclic, bcond::open, bcond::open>,
+      concurr::serial< slv_t, bcond::cyclic, bcond::cyclic, bcond::cyclic, bcond::cyclic, bcond::open, bcond::open>
+    > run(p);
+    run.advectee() = where(pow(i - nx / 2., 2) + pow(j - ny / 2., 2) + pow(k - nz / 2., 2) < 100, 4, 1);
+    run.advector(0) = .3;
+    run.advector(1) = -.2;
+    run.advector(2) = .1;
+    shmem_perf::barrier_counts().reset();
+    return shmem_perf::advance<n_dims>(run, nt);
+  }
+}
+
+// the bounds and betas at the subdomain edges exchanged between neighbours alone:
+// no full barriers added to those of the same run without FCT
+template <int n_dims, opts::opts_t opts>
+void check_barriers(const std::string &name)
+{
+  auto &counts = shmem_perf::barrier_counts();
+
+  test<true, n_dims, (opts & ~opts::fct)>(true);
+  const unsigned long long full_barriers = counts.full, nbr_barriers = counts.nbr;
+
+  test<true, n_dims, opts>(true);
+  std::cout << name << ": barriers per thread and step added by FCT: " << (double(counts.full) - full_barriers) / counts.threads / nt
+    << " full, " << (double(counts.nbr) - nbr_barriers) / counts.threads / nt << " neighbour-only" << std::endl;
+  // concurr falls back to full barriers e.g. with subdomains narrower than the halo
+  if (counts.nbr_sync && counts.threads > 1 && (counts.full != full_barriers || counts.nbr <= nbr_barriers))
+    throw std::runtime_error(name + ": FCT synchronisation not neighbour-only with nbr_sync");
+}
+
+template <int n_dims, opts::opts_t opts>
+void compare(const std::string &name)
+{
+  check_barriers<n_dims, opts>(name);
+  shmem_perf::compare<n_dims>(name, {
+    {"single thread",    test<false, n_dims, opts>()},
+    {"multiple threads", test<true,  n_dims, opts>()}
+  });
+}
+
+int main()
+{
+  compare<2, opts::fct>("2D, fct");
+  compare<2, opts::fct | opts::iga | opts::nug>("2D, fct|iga|nug");
+  compare<3, opts::fct>("3D, fct");
+  compare<3, opts::fct | opts::abs>("3D, fct|abs");
+}
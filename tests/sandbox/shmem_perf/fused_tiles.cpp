@@ -0,0 +1,99 @@
+/* 
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * wall time of a 3D run with the corrective iterations computed
+ * over the whole subdomains vs. in tiles of columns (fused_tile)
+ * (results are expected to be bitwise identical),
+ * and the rejection of the options fused_tile does not support
+ */
+
+#include <libmpdata++/solvers/mpdata.hpp>
+#include <libmpdata++/concurr/threads.hpp>
+
+#include "compare.hpp"
+
+#include <string>
+
+using namespace libmpdataxx;
+
+template <opts::opts_t opts_arg>
+struct ct_params_t : ct_params_default_t
+{
+  using real_t = double;
+  enum { n_dims = 3 };
+  enum { n_eqns = 1 };
+  enum { opts = opts_arg };
+};
+
+const int nx = 48, ny = 40, nz = 32, nt = 20;
+
+template <opts::opts_t opts>
+shmem_perf::outcome_t<3> test(const int fused_tile)
+{
+  using slv_t = solvers::mpdata<ct_params_t<opts>>;
+
+  typename slv_t::rt_params_t p;
+  p.grid_size = {nx, ny, nz};
+  p.n_iters = 3;
+  p.fused_tile = fused_tile;
+
+  concurr::threads<
+    slv_t, 
+    bcond::cyclic, bcond::cyclic,
+    bcond::cyclic, bcond::cyclic,
+    bcond::open, bcond::open
+  > run(p);
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+  blitz::thirdIndex k;
+  run.advectee() = exp(-(pow(i - nx / 2., 2) + pow(j - ny / 2., 2) + pow(k - nz / 2., 2)) / 20.);
+  if (opts::isset(opts, opts::nug))
+    run.g_factor() = exp(.1 * (cos(i * .3) + cos(j * .2)));
+  run.advector(0) = .3;
+  run.advector(1) = -.2;
+  run.advector(2) = .1;
+
+  return shmem_perf::advance<3>(run, nt);
+}
+
+template <opts::opts_t opts>
+void compare(const std::string &name)
+{
+  const auto ref = test<opts>(0);
+  for (const int fused_tile : {1, 5, 16})
+  {
+    const std::string tile = std::to_string(fused_tile);
+    shmem_perf::compare<3>(name, {
+      {"whole subdomains", ref},
+      {"tiles of " + tile + " x " + tile + " columns", test<opts>(fused_tile)}
+    });
+  }
+}
+
+template <opts::opts_t opts>
+void rejected(const std::string &name)
+{
+  try
+  {
+    test<opts>(4);
+  }
+  catch (const std::runtime_error &)
+  {
+    return;
+  }
+  throw std::runtime_error("fused_tile accepted with " + name);
+}
+
+int main()
+{
+  rejected<opts::dfl>("dfl");
+  rejected<opts::iga | opts::fct>("iga|fct");
+
+  compare<0>("default options");
+  compare<opts::abs>("abs");
+  compare<opts::abs | opts::nug>("abs|nug");
+}
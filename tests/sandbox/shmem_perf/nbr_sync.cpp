@@ -0,0 +1,81 @@
+/* 
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * wall time of a 3D advection run with halo exchanges synchronised
+ * with all-thread barriers vs. with neighbouring subdomains only
+ * (results are expected to be bitwise identical, and the latter
+ * to replace some of the all-thread barriers with neighbour-only ones)
+ */
+
+#include <libmpdata++/solvers/mpdata.hpp>
+#include <libmpdata++/concurr/threads.hpp>
+
+#include "compare.hpp"
+
+using namespace libmpdataxx;
+
+struct ct_params_t : ct_params_default_t
+{
+  using real_t = double;
+  enum { n_dims = 3 };
+  enum { n_eqns = 1 };
+  enum { opts = opts::iga | opts::fct };
+};
+
+const int nx = 48, ny = 48, nz = 48, nt = 50;
+
+shmem_perf::outcome_t<3> test(const bool nbr_sync)
+{
+  using slv_t = shmem_perf::counted<solvers::mpdata<ct_params_t>>;
+
+  typename slv_t::rt_params_t p;
+  p.grid_size = {nx, ny, nz};
+  p.nbr_sync = nbr_sync;
+
+  concurr::threads<
+    slv_t, 
+    bcond::cyclic, bcond::cyclic,
+    bcond::cyclic, bcond::cyclic,
+    bcond::open, bcond::open
+  > run(p);
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+  blitz::thirdIndex k;
+  run.advectee() = exp(-(pow(i - nx / 2., 2) + pow(j - ny / 2., 2) + pow(k - nz / 2., 2)) / 20.);
+  run.advector(0) = .3;
+  run.advector(1) = -.2;
+  run.advector(2) = 0;
+
+  shmem_perf::barrier_counts().reset();
+  return shmem_perf::advance<3>(run, nt);
+}
+
+int main()
+{
+  auto &counts = shmem_perf::barrier_counts();
+
+  const auto full = test(false);
+  const unsigned long long full_barriers = counts.full;
+  if (counts.nbr != 0) throw std::runtime_error("neighbour-only barriers without nbr_sync");
+
+  const auto nbr = test(true);
+  std::cout << "barriers per thread and step: " << double(full_barriers) / counts.threads / nt << " full vs. "
+    << double(counts.full) / counts.threads / nt << " full + " << double(counts.nbr) / counts.threads / nt << " neighbour-only" << std::endl;
+  // concurr falls back to full barriers e.g. with subdomains narrower than the halo
+  if (counts.nbr_sync && counts.threads > 1)
+  {
+    if (counts.nbr == 0 || counts.full + counts.nbr != full_barriers)
+      throw std::runtime_error("nbr_sync did not replace full barriers with neighbour-only ones");
+  }
+  else if (counts.full != full_barriers)
+    throw std::runtime_error("different numbers of barriers without neighbour-only synchronisation");
+
+  shmem_perf::compare<3>("halo exchanges", {
+    {"full barriers",  full},
+    {"neighbour-only", nbr}
+  });
+}
@@ -0,0 +1,119 @@
+/* 
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * wall time of a memory-bound 3D advection run for different placements
+ * of the shared arrays on NUMA nodes (default: pages touched by the master
+ * thread, first touch by the worker threads, interleaved); on multi-socket
+ * nodes run with OMP_NUM_THREADS spanning the sockets and threads pinned
+ * (e.g. OMP_PROC_BIND=spread) to see the bandwidth scaling
+ * (results are expected to be bitwise identical); checks also (on Linux) that
+ * the pages of the advectee are interleaved, or with first touch, on the NUMA
+ * node of the thread computing on them
+ */
+
+#include <libmpdata++/solvers/mpdata.hpp>
+#include <libmpdata++/concurr/threads.hpp>
+
+#include <atomic>
+
+#include "compare.hpp"
+
+using namespace libmpdataxx;
+
+// placement of the advectee pages within the subdomain of each solver, seen from its thread
+// before the time loop (a sample of cells, as each is one syscall)
+std::atomic<int> n_cells(0), n_local(0), n_interleaved(0);
+
+template <class slv_t>
+struct placement_check : slv_t
+{
+  using slv_t::slv_t;
+
+  void hook_ante_loop(const typename slv_t::advance_arg_t nt)
+  {
+    slv_t::hook_ante_loop(nt);
+#if defined(__linux__) && defined(SYS_get_mempolicy) && defined(SYS_getcpu)
+    unsigned cpu, node;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) return;
+
+    const auto psi = this->mem->advectee();
+    const int step = 4;
+    for (int i = this->ijk.lbound(0); i <= this->ijk.ubound(0); i += step)
+      for (int j = this->ijk.lbound(1); j <= this->ijk.ubound(1); j += step)
+        for (int k = this->ijk.lbound(2); k <= this->ijk.ubound(2); k += step)
+        {
+          void *addr = const_cast<double*>(&psi(i, j, k));
+          int page_node, mode;
+          if (
+            syscall(SYS_get_mempolicy, &page_node, nullptr, 0, addr, MPOL_F_NODE | MPOL_F_ADDR) != 0 ||
+            syscall(SYS_get_mempolicy, &mode, nullptr, 0, addr, MPOL_F_ADDR) != 0
+          ) return; // e.g. kernels without NUMA support
+          ++n_cells;
+          if (page_node == int(node)) ++n_local;
+          if (mode == MPOL_INTERLEAVE) ++n_interleaved;
+        }
+#endif
+  }
+};
+
+struct ct_params_t : ct_params_default_t
+{
+  using real_t = double;
+  enum { n_dims = 3 };
+  enum { n_eqns = 1 };
+  enum { opts = opts::iga | opts::fct };
+};
+
+const int nx = 128, ny = 128, nz = 128, nt = 20;
+
+shmem_perf::outcome_t<3> test(const concurr::numa_alloc_t numa_alloc)
+{
+  using slv_t = placement_check<solvers::mpdata<ct_params_t>>;
+
+  typename slv_t::rt_params_t p;
+  p.grid_size = {nx, ny, nz};
+  p.thread_pool = true; // same threads for the first touch and for the computations
+  p.numa_alloc = numa_alloc;
+  p.affinity = "compact"; // threads staying on the nodes of their pages
+
+  concurr::threads<
+    slv_t, 
+    bcond::cyclic, bcond::cyclic,
+    bcond::cyclic, bcond::cyclic,
+    bcond::cyclic, bcond::cyclic
+  > run(p);
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+  blitz::thirdIndex k;
+  run.advectee() = exp(-(pow(i - nx / 2., 2) + pow(j - ny / 2., 2) + pow(k - nz / 2., 2)) / 100.);
+  run.advector(0) = .3;
+  run.advector(1) = -.2;
+  run.advector(2) = .1;
+
+  n_cells = n_local = n_interleaved = 0;
+  const auto ret = shmem_perf::advance<3>(run, nt);
+
+  // all sampled pages interleaved, or (allowing for pages shared by neighbouring subdomains) nearly all
+  // on the node of the thread computing on them, the latter not in debug builds where the arrays
+  // are filled with NaNs by the master thread when allocated
+  if (numa_alloc == concurr::numa_interleave && n_interleaved != n_cells)
+    throw std::runtime_error("advectee pages not interleaved");
+#if defined(NDEBUG)
+  if (numa_alloc == concurr::numa_first_touch && n_local < .9 * n_cells)
+    throw std::runtime_error("advectee pages first touched by threads other than those computing on them");
+#endif
+  return ret;
+}
+
+int main()
+{
+  shmem_perf::compare<3>("NUMA allocation policies", {
+    {"default",     test(concurr::numa_default)},
+    {"first touch", test(concurr::numa_first_touch)},
+    {"interleave",  test(concurr::numa_interleave)}
+  });
+}
@@ -0,0 +1,145 @@
+/* 
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * advection with slab boundaries shifted between threads every few
+ * time steps (measured load rebalancing), compared against
+ * a single-threaded run (results are expected to be bitwise identical),
+ * with the first thread slowed down by sleeping in each time step
+ * (its slab is expected to shrink)
+ */
+
+#include <libmpdata++/solvers/mpdata.hpp>
+#include <libmpdata++/concurr/cxx11_thread.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include "compare.hpp"
+
+using namespace libmpdataxx;
+
+template <int n_dims_arg>
+struct ct_params_t : ct_params_default_t
+{
+  using real_t = double;
+  enum { n_dims = n_dims_arg };
+  enum { n_eqns = 1 };
+  enum { opts = opts::iga | opts::fct };
+};
+
+const int nt = 40;
+
+// widths of the slab of the first thread at the first time step and the narrowest one seen
+std::atomic<int> width_0, width_min;
+
+template <class slv_t>
+struct slowed : slv_t
+{
+  using slv_t::slv_t;
+
+  void hook_ante_step()
+  {
+    slv_t::hook_ante_step();
+    if (this->rank != 0) return;
+    const int width = this->ijk[this->mem->shmem_decomp_dim].length();
+    if (this->timestep == 0) width_0 = width_min = width;
+    width_min = std::min<int>(width_min, width);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+};
+
+void check_shrunk(const char *nthreads)
+{
+  if (std::string(nthreads) != "1" && width_min >= width_0)
+    throw std::runtime_error("slab of the slowed-down thread not shrunk");
+}
+
+// advanced in single steps for the first half (rebalancing windows spanning advance() calls)
+// and at once for the second half (windows within a single advance() call)
+template <int n_dims, class run_t>
+shmem_perf::outcome_t<n_dims> advance(run_t &run)
+{
+  const auto first = shmem_perf::advance<n_dims>(run, nt / 2, 1, 1);
+  auto ret = shmem_perf::advance<n_dims>(run, nt / 2);
+  ret.time += first.time;
+  return ret;
+}
+
+shmem_perf::outcome_t<2> test_2d(const char *nthreads, const bool nbr_sync)
+{
+  using slv_t = slowed<solvers::mpdata<ct_params_t<2>>>;
+  const int nx = 48, ny = 24;
+
+  setenv("OMP_NUM_THREADS", nthreads, 1);
+
+  typename slv_t::rt_params_t p;
+  p.grid_size = {nx, ny};
+  p.nbr_sync = nbr_sync;
+  p.rebalance = 3;
+
+  concurr::cxx11_thread<
+    slv_t, 
+    bcond::open, bcond::open,
+    bcond::cyclic, bcond::cyclic
+  > run(p);
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+  run.advectee() = exp(-(pow(i - nx / 2., 2) + pow(j - ny / 2., 2)) / 8.);
+  run.advector(0) = .3;
+  run.advector(1) = -.2;
+  const auto ret = advance<2>(run);
+  check_shrunk(nthreads);
+  return ret;
+}
+
+shmem_perf::outcome_t<3> test_3d(const char *nthreads)
+{
+  using slv_t = slowed<solvers::mpdata<ct_params_t<3>>>;
+  const int nx = 12, ny = 24, nz = 8;
+
+  setenv("OMP_NUM_THREADS", nthreads, 1);
+
+  typename slv_t::rt_params_t p;
+  p.grid_size = {nx, ny, nz};
+  p.rebalance = 2;
+
+  concurr::cxx11_thread<
+    slv_t, 
+    bcond::cyclic, bcond::cyclic,
+    bcond::open, bcond::open,
+    bcond::cyclic, bcond::cyclic
+  > run(p);
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+  blitz::thirdIndex k;
+  run.advectee() = exp(-(pow(i - nx / 2., 2) + pow(j - ny / 2., 2) + pow(k - nz / 2., 2)) / 8.);
+  run.advector(0) = .3;
+  run.advector(1) = -.2;
+  run.advector(2) = .1;
+  const auto ret = advance<3>(run);
+  check_shrunk(nthreads);
+  return ret;
+}
+
+int main()
+{
+  for (const bool nbr_sync : {false, true})
+  {
+    shmem_perf::compare<2>(nbr_sync ? "2D, neighbour-only sync" : "2D", {
+      {"1 thread",  test_2d("1", nbr_sync)},
+      {"4 threads, rebalanced", test_2d("4", nbr_sync)}
+    });
+  }
+  shmem_perf::compare<3>("3D", {
+    {"1 thread",  test_3d("1")},
+    {"4 threads, rebalanced", test_3d("4")}
+  });
+}
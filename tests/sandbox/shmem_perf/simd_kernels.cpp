@@ -0,0 +1,129 @@
+/*
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * wall time of 1D, 2D and 3D runs with the donor-cell and antidiffusive velocity
+ * formulae evaluated by Blitz++ expressions (simd_kernels, saving the results)
+ * vs. in explicitly vectorised loops (simd_kernels_simd built with LIBMPDATAXX_SIMD,
+ * comparing the results with the saved ones), the file given as the argument
+ */
+
+#include <libmpdata++/solvers/mpdata.hpp>
+#include <libmpdata++/concurr/threads.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace libmpdataxx;
+
+template <int n_dims_arg, opts::opts_t opts_arg>
+struct ct_params_t : ct_params_default_t
+{
+  using real_t = double;
+  enum { n_dims = n_dims_arg };
+  enum { n_eqns = 1 };
+  enum { opts = opts_arg };
+};
+
+const int nx = 48, ny = 40, nz = 32, nt = 20;
+
+#if defined(LIBMPDATAXX_SIMD)
+using ref_t = std::ifstream;
+#else
+using ref_t = std::ofstream;
+#endif
+
+template <int n_dims, opts::opts_t opts>
+void test(const std::string &name, ref_t &ref)
+{
+  using slv_t = solvers::mpdata<ct_params_t<n_dims, opts>>;
+
+  typename slv_t::rt_params_t p;
+  p.n_iters = 3;
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+  blitz::thirdIndex k;
+
+  blitz::Array<double, n_dims> result;
+  double time;
+
+  const auto run_and_time = [&](auto &run) {
+    auto t0 = std::chrono::steady_clock::now();
+    run.advance(nt);
+    auto t1 = std::chrono::steady_clock::now();
+    time = std::chrono::duration<double>(t1 - t0).count();
+    result.resize(run.advectee().shape());
+    result = run.advectee();
+  };
+
+  if constexpr (n_dims == 1)
+  {
+    p.grid_size = {nx * ny * nz};
+    concurr::threads<slv_t, bcond::cyclic, bcond::cyclic> run(p);
+    run.advectee() = exp(-pow(i - nx * ny * nz / 2., 2) / 2000.);
+    run.advector() = .3;
+    run_and_time(run);
+  }
+  else if constexpr (n_dims == 2)
+  {
+    p.grid_size = {nx * nz, ny};
+    concurr::threads<slv_t, bcond::cyclic, bcond::cyclic, bcond::cyclic, bcond::cyclic> run(p);
+    run.advectee() = exp(-(pow(i - nx * nz / 2., 2) + pow(j - ny / 2., 2)) / 200.);
+    if (opts::isset(opts, opts::nug))
+      run.g_factor() = exp(.1 * (cos(i * .3) + cos(j * .2)));
+    run.advector(0) = .3;
+    run.advector(1) = -.2;
+    run_and_time(run);
+  }
+  else
+  {
+    p.grid_size = {nx, ny, nz};
+    concurr::threads<
+      slv_t,
+      bcond::cyclic, bcond::cyclic,
+      bcond::cyclic, bcond::cyclic,
+      bcond::open, bcond::open
+    > run(p);
+    run.advectee() = exp(-(pow(i - nx / 2., 2) + pow(j - ny / 2., 2) + pow(k - nz / 2., 2)) / 20.);
+    run.advector(0) = .3;
+    run.advector(1) = -.2;
+    run.advector(2) = .1;
+    run_and_time(run);
+  }
+
+  const std::size_t size = result.numElements() * sizeof(double);
+#if defined(LIBMPDATAXX_SIMD)
+  std::cout << name << ": explicitly vectorised: " << time << " s" << std::endl;
+
+  // not necessarily bitwise identical, e.g. due to different contractions into fused multiply-adds
+  blitz::Array<double, n_dims> expected(result.shape());
+  if (!ref.read(reinterpret_cast<char*>(expected.dataFirst()), size))
+    throw std::runtime_error("reference file too short (not written by simd_kernels?)");
+  if (max(abs(result - expected)) > 1e-12 * max(abs(expected)))
+    throw std::runtime_error("results differ with LIBMPDATAXX_SIMD: " + name);
+#else
+  std::cout << name << ": Blitz++ expressions: " << time << " s" << std::endl;
+  ref.write(reinterpret_cast<const char*>(result.dataFirst()), size);
+#endif
+}
+
+int main(int argc, char **argv)
+{
+  if (argc != 2)
+    throw std::runtime_error("usage: " + std::string(argv[0]) + " <reference file>");
+  ref_t ref(argv[1], std::ios::binary);
+  if (!ref)
+    throw std::runtime_error("cannot open " + std::string(argv[1]));
+
+  test<1, 0>("1D, default options", ref);
+  test<1, opts::abs>("1D, abs", ref);
+  test<2, opts::iga>("2D, iga", ref);
+  test<2, opts::abs | opts::nug>("2D, abs|nug", ref);
+  test<3, 0>("3D, default options", ref);
+  test<3, opts::abs | opts::pfc>("3D, abs|pfc", ref);
+}
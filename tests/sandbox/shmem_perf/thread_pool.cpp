@@ -0,0 +1,86 @@
+/* 
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * per-call overhead of advance(1) on a small grid with threads
+ * spawned on each call vs. threads kept in a persistent pool
+ * (the latter expected to run each solver in the same thread in all calls)
+ */
+
+#include <libmpdata++/solvers/mpdata.hpp>
+#include <libmpdata++/concurr/cxx11_thread.hpp>
+#include <libmpdata++/concurr/boost_thread.hpp>
+
+#include "compare.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace libmpdataxx;
+
+// number of time steps done by a solver in a different thread than the previous one
+std::atomic<int> n_moved(0);
+
+template <class slv_t>
+struct thread_check : slv_t
+{
+  using slv_t::slv_t;
+
+  bool started = false;
+  std::thread::id last;
+
+  void hook_ante_step()
+  {
+    slv_t::hook_ante_step();
+    if (started && std::this_thread::get_id() != last) ++n_moved;
+    started = true;
+    last = std::this_thread::get_id();
+  }
+};
+
+struct ct_params_t : ct_params_default_t
+{
+  using real_t = double;
+  enum { n_dims = 2 };
+  enum { n_eqns = 1 };
+};
+
+const int nx = 32, ny = 32, n_calls = 2000;
+
+template <template <class, bcond::bcond_e, bcond::bcond_e, bcond::bcond_e, bcond::bcond_e, bcond::bcond_e, bcond::bcond_e> class concurr_t>
+shmem_perf::outcome_t<2> test(const bool thread_pool)
+{
+  using slv_t = thread_check<solvers::mpdata<ct_params_t>>;
+
+  typename slv_t::rt_params_t p;
+  p.grid_size = {nx, ny};
+  p.thread_pool = thread_pool;
+
+  concurr_t<slv_t, bcond::cyclic, bcond::cyclic, bcond::cyclic, bcond::cyclic, bcond::null, bcond::null> run(p);
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+  run.advectee() = exp(-(pow(i - nx / 2., 2) + pow(j - ny / 2., 2)) / 20.);
+  run.advector(0) = .3;
+  run.advector(1) = -.2;
+
+  n_moved = 0;
+  auto ret = shmem_perf::advance<2>(run, n_calls, 1, 1);
+  if (thread_pool && n_moved != 0)
+    throw std::runtime_error("solvers run by different pool threads in different advance() calls");
+  return ret;
+}
+
+int main()
+{
+  shmem_perf::compare<2>("cxx11_thread, " + std::to_string(n_calls) + " calls", {
+    {"spawn", test<concurr::cxx11_thread>(false)},
+    {"pool",  test<concurr::cxx11_thread>(true)}
+  });
+  shmem_perf::compare<2>("boost_thread, " + std::to_string(n_calls) + " calls", {
+    {"spawn", test<concurr::boost_thread>(false)},
+    {"pool",  test<concurr::boost_thread>(true)}
+  });
+}
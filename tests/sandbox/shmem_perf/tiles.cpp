@@ -0,0 +1,143 @@
+/* 
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * advection on grids narrower (in the shared-memory decomposition
+ * dimension) than the number of threads, i.e. with the domain split
+ * into 2D tiles, compared against a single-threaded run
+ * (results are expected to be bitwise identical; std::thread backend
+ * used as it reads OMP_NUM_THREADS at construction), checking also that
+ * every solver computes the subdomain its thread initialises
+ */
+
+#include <libmpdata++/solvers/mpdata.hpp>
+#include <libmpdata++/concurr/cxx11_thread.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "compare.hpp"
+
+using namespace libmpdataxx;
+
+// the thread that wrote each cell in advectee_init() (where each thread of the pool
+// assigns its own part), compared in hook_ante_loop() with the thread running the
+// solver whose subdomain the cell is in
+std::map<std::vector<int>, std::thread::id> owner;
+std::mutex owner_mtx;
+std::atomic<bool> owner_mismatch(false);
+
+template <class slv_t>
+struct owner_check : slv_t
+{
+  using slv_t::slv_t;
+
+  static double init(const blitz::TinyVector<int, slv_t::n_dims> &ijk, const double val)
+  {
+    std::vector<int> key(slv_t::n_dims);
+    for (int d = 0; d < slv_t::n_dims; ++d) key[d] = ijk[d];
+    std::lock_guard<std::mutex> lock(owner_mtx);
+    owner[key] = std::this_thread::get_id();
+    return val;
+  }
+
+  void hook_ante_loop(const typename slv_t::advance_arg_t nt)
+  {
+    slv_t::hook_ante_loop(nt);
+
+    std::vector<int> ijk(slv_t::n_dims);
+    for (int d = 0; d < slv_t::n_dims; ++d) ijk[d] = this->ijk.lbound(d);
+    for (int d = 0; d >= 0;)
+    {
+      if (owner.at(ijk) != std::this_thread::get_id()) owner_mismatch = true;
+      for (d = slv_t::n_dims - 1; d >= 0 && ++ijk[d] > this->ijk.ubound(d); --d)
+        ijk[d] = this->ijk.lbound(d);
+    }
+  }
+};
+
+template <int n_dims_arg>
+struct ct_params_t : ct_params_default_t
+{
+  using real_t = double;
+  enum { n_dims = n_dims_arg };
+  enum { n_eqns = 1 };
+  enum { opts = opts::iga | opts::fct };
+};
+
+const int nt = 20;
+
+shmem_perf::outcome_t<2> test_2d(const char *nthreads)
+{
+  using slv_t = owner_check<solvers::mpdata<ct_params_t<2>>>;
+  const int nx = 4, ny = 24;
+
+  setenv("OMP_NUM_THREADS", nthreads, 1);
+
+  typename slv_t::rt_params_t p;
+  p.grid_size = {nx, ny};
+  p.thread_pool = true; // the same threads in advectee_init() and advance()
+
+  concurr::cxx11_thread<
+    slv_t, 
+    bcond::cyclic, bcond::cyclic,
+    bcond::open, bcond::open
+  > run(p);
+
+  run.advectee_init([](const blitz::TinyVector<int, 2> &ijk) {
+    const int i = ijk[0], j = ijk[1];
+    return slv_t::init(ijk, exp(-(pow(i - nx / 2., 2) + pow(j - ny / 2., 2)) / 8.));
+  });
+  run.advector(0) = .3;
+  run.advector(1) = -.2;
+  return shmem_perf::advance<2>(run, nt);
+}
+
+shmem_perf::outcome_t<3> test_3d(const char *nthreads)
+{
+  using slv_t = owner_check<solvers::mpdata<ct_params_t<3>>>;
+  const int nx = 16, ny = 3, nz = 8;
+
+  setenv("OMP_NUM_THREADS", nthreads, 1);
+
+  typename slv_t::rt_params_t p;
+  p.grid_size = {nx, ny, nz};
+  p.thread_pool = true;
+
+  concurr::cxx11_thread<
+    slv_t, 
+    bcond::open, bcond::open,
+    bcond::cyclic, bcond::cyclic,
+    bcond::cyclic, bcond::cyclic
+  > run(p);
+
+  run.advectee_init([](const blitz::TinyVector<int, 3> &ijk) {
+    const int i = ijk[0], j = ijk[1], k = ijk[2];
+    return slv_t::init(ijk, exp(-(pow(i - nx / 2., 2) + pow(j - ny / 2., 2) + pow(k - nz / 2., 2)) / 8.));
+  });
+  run.advector(0) = .3;
+  run.advector(1) = -.2;
+  run.advector(2) = .1;
+  return shmem_perf::advance<3>(run, nt);
+}
+
+int main()
+{
+  shmem_perf::compare<2>("2D", {
+    {"slabs", test_2d("1")},
+    {"4 x 2 tiles", test_2d("8")}
+  });
+  shmem_perf::compare<3>("3D", {
+    {"slabs", test_3d("1")},
+    {"3 x 2 tiles", test_3d("6")}
+  });
+
+  if (owner_mismatch)
+    throw std::runtime_error("solvers compute subdomains initialised by other threads");
+}
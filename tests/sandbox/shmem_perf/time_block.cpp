@@ -0,0 +1,118 @@
+/*
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * wall time of a 2D rotating-cone and a 3D revolving-sphere run (with periodic
+ * boundaries) advancing the advectee step by step vs. in blocks of time steps
+ * computed tile after tile (time_block, time_block_tile)
+ * (results are expected to be bitwise identical, and the halos to be exchanged
+ * once per block, i.e. at most 1/time_block of the step-by-step barriers to be left)
+ */
+
+#include <libmpdata++/solvers/mpdata.hpp>
+#include <libmpdata++/concurr/threads.hpp>
+
+#include "compare.hpp"
+
+#include <string>
+
+using namespace libmpdataxx;
+
+template <int n_dims_arg, opts::opts_t opts_arg>
+struct ct_params_t : ct_params_default_t
+{
+  using real_t = double;
+  enum { n_dims = n_dims_arg };
+  enum { n_eqns = 1 };
+  enum { opts = opts_arg };
+};
+
+// deep enough for blocks of 3 time steps with 2 iterations
+const int minhalo = 6, nt = 24;
+
+template <int n_dims, opts::opts_t opts>
+shmem_perf::outcome_t<n_dims> test(const int time_block, const int time_block_tile)
+{
+  using slv_t = shmem_perf::counted<solvers::mpdata<ct_params_t<n_dims, opts>, minhalo>>;
+
+  typename slv_t::rt_params_t p;
+  p.n_iters = 2;
+  p.time_block = time_block;
+  p.time_block_tile = time_block_tile;
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+  blitz::thirdIndex k;
+
+  if constexpr (n_dims == 2)
+  {
+    // a cone in a solid-body rotation
+    const int nx = 200, ny = 200;
+    const double omega = .01;
+    p.grid_size = {nx, ny};
+    concurr::threads<slv_t, bcond::cyclic, bcond::cyclic, bcond::cyclic, bcond::cyclic> run(p);
+    run.advectee() = where(pow(i - nx / 2., 2) + pow(j - ny * .75, 2) < 225, 4 * (1 - sqrt(pow(i - nx / 2., 2) + pow(j - ny * .75, 2)) / 15), 0);
+    if (opts::isset(opts, opts::nug))
+      run.g_factor() = exp(.1 * (cos(i * .3) + cos(j * .2)));
+    run.advector(0) = -omega * (j - ny / 2.);
+    run.advector(1) =  omega * (i + .5 - nx / 2.);
+    shmem_perf::barrier_counts().reset();
+    return shmem_perf::advance<n_dims>(run, nt);
+  }
+  else
+  {
+    // a sphere moving along the diagonal
+    const int nx = 48, ny = 48, nz = 48;
+    p.grid_size = {nx, ny, nz};
+    concurr::threads<
+      slv_t,
+      bcond::cyclic, bcond::cyclic,
+      bcond::cyclic, bcond::cyclic,
+      bcond::cyclic, bcond::cyclic
+    > run(p);
+    run.advectee() = where(pow(i - nx / 2., 2) + pow(j - ny / 2., 2) + pow(k - nz / 2., 2) < 100, 4, 0);
+    run.advector(0) = .3;
+    run.advector(1) = .2;
+    run.advector(2) = .1;
+    shmem_perf::barrier_counts().reset();
+    return shmem_perf::advance<n_dims>(run, nt);
+  }
+}
+
+template <int n_dims, opts::opts_t opts>
+void compare(const std::string &name)
+{
+  auto &counts = shmem_perf::barrier_counts();
+
+  const auto ref = test<n_dims, opts>(1, 0);
+  const unsigned long long ref_barriers = counts.full + counts.nbr;
+  for (const int time_block : {2, 3})
+  {
+    for (const int time_block_tile : {0, 16})
+    {
+      const std::string cfg = "blocks of " + std::to_string(time_block) + " steps, tiles of " + std::to_string(time_block_tile) + " cells";
+      const auto blk = test<n_dims, opts>(time_block, time_block_tile);
+      const unsigned long long barriers = counts.full + counts.nbr;
+      std::cout << "barriers per thread: " << double(ref_barriers) / counts.threads << " vs. " << double(barriers) / counts.threads << std::endl;
+      if (barriers * time_block > ref_barriers)
+        throw std::runtime_error(name + ", " + cfg + ": more than one halo exchange per block");
+
+      shmem_perf::compare<n_dims>(name, {
+        {"step by step", ref},
+        {cfg, blk}
+      });
+    }
+  }
+}
+
+int main()
+{
+  compare<2, 0>("2D, default options");
+  compare<2, opts::abs>("2D, abs");
+  compare<2, opts::iga>("2D, iga");
+  compare<2, opts::nug>("2D, nug");
+  compare<3, 0>("3D, default options");
+  compare<3, opts::iga>("3D, iga");
+}
@@ -0,0 +1,96 @@
+/** 
+ * @file
+ * @copyright University of Warsaw
+ * @section LICENSE
+ * GPLv3+ (see the COPYING file or http://www.gnu.org/licenses/)
+ *
+ * batched reductions (sharedmem::reduce()) compared with sum(), min() and max()
+ * called one after another, with threads and (if built with it) MPI processes;
+ * the batch is longer than sharedmem::max_batch to be done in chunks
+ */
+
+#include <libmpdata++/solvers/mpdata.hpp>
+#include <libmpdata++/concurr/threads.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <iostream>
+
+using namespace libmpdataxx;
+
+std::atomic<int> n_failed(0);
+
+template <class slv_t>
+struct reduce_check : slv_t
+{
+  using slv_t::slv_t;
+  using mem_t = typename slv_t::mem_t;
+
+  void check(const bool sum_khn)
+  {
+    const auto &a = this->mem->psi[0][this->n[0]], &b = this->mem->psi[1][this->n[1]];
+    const auto &ijk = this->ijk;
+
+    const auto res = this->mem->reduce(this->rank, {
+      mem_t::sum_of(a), mem_t::max_of(b), mem_t::sum_of(a, b), mem_t::min_of(a), mem_t::max_of(a),
+      mem_t::sum_of(b), mem_t::min_of(b), mem_t::sum_of(b, b), mem_t::sum_of(a, a), mem_t::min_of(b)
+    }, ijk, sum_khn);
+    static_assert(mem_t::max_batch < 10, "");
+
+    const std::vector<double> ref = {
+      this->mem->sum(this->rank, a, ijk, sum_khn), double(this->mem->max(this->rank, b(ijk))),
+      this->mem->sum(this->rank, a, b, ijk, sum_khn), double(this->mem->min(this->rank, a(ijk))),
+      double(this->mem->max(this->rank, a(ijk))), this->mem->sum(this->rank, b, ijk, sum_khn),
+      double(this->mem->min(this->rank, b(ijk))), this->mem->sum(this->rank, b, b, ijk, sum_khn),
+      this->mem->sum(this->rank, a, a, ijk, sum_khn), double(this->mem->min(this->rank, b(ijk)))
+    };
+
+    for (std::size_t r = 0; r < ref.size(); ++r)
+    {
+      // the sums across processes of several values at once might be added up in a different order
+      if (std::abs(res[r] - ref[r]) > 1e-13 * std::abs(ref[r]))
+      {
+        std::cerr << "entry " << r << " (sum_khn=" << sum_khn << "): " << res[r] << " instead of " << ref[r] << std::endl;
+        ++n_failed;
+      }
+    }
+  }
+
+  void hook_ante_loop(const typename slv_t::advance_arg_t nt)
+  {
+    slv_t::hook_ante_loop(nt);
+    check(false);
+    check(true);
+  }
+};
+
+struct ct_params_t : ct_params_default_t
+{
+  using real_t = double;
+  enum { n_dims = 2 };
+  enum { n_eqns = 2 };
+};
+
+int main()
+{
+  using slv_t = reduce_check<solvers::mpdata<ct_params_t>>;
+  typename slv_t::rt_params_t p;
+  p.grid_size = {30, 20};
+
+  concurr::threads<
+    slv_t,
+    bcond::cyclic, bcond::cyclic,
+    bcond::cyclic, bcond::cyclic
+  > run(p);
+
+  blitz::firstIndex i;
+  blitz::secondIndex j;
+  run.advectee_init(sin(i * .3) + cos(j * .2), 0);
+  run.advectee_init(i * (j - 7.) / 10., 1);
+  run.advector(0) = 0;
+  run.advector(1) = 0;
+
+  run.advance(1);
+
+  if (n_failed > 0) throw std::runtime_error("batched reductions differ from those done one after another");
+}